@@ -0,0 +1,189 @@
+#include "mine_sweeper_board_pool.h"
+#include "mine_sweeper_storage.h"
+
+#define MINESWEEPER_BOARD_POOL_MAGIC 0x5042534D // "MSBP" as little endian bytes
+#define MINESWEEPER_BOARD_POOL_VERSION 1
+#define MINESWEEPER_BOARD_POOL_PATH_FORMAT CONFIG_FILE_DIRECTORY_PATH "/board_pool_%ux%u_%u.bin"
+
+typedef struct {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t width, height, difficulty;
+} MineSweeperBoardPoolHeader;
+
+// Largest record is the seed followed by the bits of a full size board
+static uint8_t pool_record[sizeof(uint64_t) + MINESWEEPER_BOARD_MINE_BITS_SIZE(MINESWEEPER_BOARD_MAX_TILES, 1)];
+
+static void mine_sweeper_board_pool_get_path(FuriString* path, uint8_t width, uint8_t height, uint8_t difficulty) {
+    furi_string_printf(path, MINESWEEPER_BOARD_POOL_PATH_FORMAT, width, height, difficulty);
+}
+
+static uint16_t mine_sweeper_board_pool_record_size(uint8_t width, uint8_t height) {
+    return sizeof(uint64_t) + MINESWEEPER_BOARD_MINE_BITS_SIZE(width, height);
+}
+
+static inline bool mine_sweeper_board_pool_is_canceled(const volatile bool* is_canceled) {
+    return is_canceled != NULL && *is_canceled;
+}
+
+/**
+ * Opens the pool file and checks its header, a file that does not match is emptied when is_writing.
+ * Returns the number of whole records in the file, or -1 if it cannot be used.
+ */
+static int32_t mine_sweeper_board_pool_open(
+        File* file,
+        uint8_t width,
+        uint8_t height,
+        uint8_t difficulty,
+        bool is_writing) {
+
+    FuriString* path = furi_string_alloc();
+    mine_sweeper_board_pool_get_path(path, width, height, difficulty);
+
+    bool is_open = storage_file_open(
+            file,
+            furi_string_get_cstr(path),
+            FSAM_READ_WRITE,
+            is_writing ? FSOM_OPEN_ALWAYS : FSOM_OPEN_EXISTING);
+
+    furi_string_free(path);
+
+    if (!is_open) {
+        return -1;
+    }
+
+    const MineSweeperBoardPoolHeader expected = {
+        .magic = MINESWEEPER_BOARD_POOL_MAGIC,
+        .version = MINESWEEPER_BOARD_POOL_VERSION,
+        .width = width,
+        .height = height,
+        .difficulty = difficulty,
+    };
+
+    MineSweeperBoardPoolHeader header;
+    uint64_t file_size = storage_file_size(file);
+
+    bool is_valid = file_size >= sizeof(header) &&
+                    storage_file_read(file, &header, sizeof(header)) == sizeof(header) &&
+                    memcmp(&header, &expected, sizeof(header)) == 0;
+
+    if (is_valid) {
+        return (file_size - sizeof(header)) / mine_sweeper_board_pool_record_size(width, height);
+    }
+
+    if (!is_writing) {
+        return 0;
+    }
+
+    // New or stale file, start it over
+    if (!storage_file_seek(file, 0, true) ||
+        !storage_file_truncate(file) ||
+        storage_file_write(file, &expected, sizeof(expected)) != sizeof(expected)) {
+        return -1;
+    }
+
+    return 0;
+}
+
+uint16_t mine_sweeper_board_pool_count(uint8_t width, uint8_t height, uint8_t difficulty) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+
+    int32_t count = mine_sweeper_board_pool_open(file, width, height, difficulty, false);
+
+    storage_file_close(file);
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    return (count > 0) ? count : 0;
+}
+
+bool mine_sweeper_board_pool_push(
+        const MineSweeperTile* board,
+        uint8_t width,
+        uint8_t height,
+        uint8_t difficulty,
+        uint64_t seed,
+        const volatile bool* is_canceled) {
+
+    furi_assert(board);
+
+    // Opening for writing can already create the directory or rewrite a stale header
+    if (mine_sweeper_board_pool_is_canceled(is_canceled)) {
+        return false;
+    }
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+
+    if (storage_common_stat(storage, CONFIG_FILE_DIRECTORY_PATH, NULL) == FSE_NOT_EXIST) {
+        storage_simply_mkdir(storage, CONFIG_FILE_DIRECTORY_PATH);
+    }
+
+    File* file = storage_file_alloc(storage);
+
+    const uint16_t record_size = mine_sweeper_board_pool_record_size(width, height);
+    int32_t count = mine_sweeper_board_pool_open(file, width, height, difficulty, true);
+    bool is_pushed = false;
+
+    if (count >= 0 && count < MINESWEEPER_BOARD_POOL_CAPACITY) {
+        memcpy(pool_record, &seed, sizeof(seed));
+        pack_board_mines(board, width, height, pool_record + sizeof(seed));
+
+        // Writing right after the last whole record also drops a record cut short by an earlier failed write
+        is_pushed = !mine_sweeper_board_pool_is_canceled(is_canceled) &&
+                    storage_file_seek(file, sizeof(MineSweeperBoardPoolHeader) + count * record_size, true) &&
+                    storage_file_write(file, pool_record, record_size) == record_size;
+
+        // A canceled push keeps the record it wrote, the next push cuts off anything left after it
+        if (is_pushed && !mine_sweeper_board_pool_is_canceled(is_canceled)) {
+            is_pushed = storage_file_truncate(file);
+        }
+    }
+
+    storage_file_close(file);
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    return is_pushed;
+}
+
+bool mine_sweeper_board_pool_pop(
+        MineSweeperTile* board,
+        uint8_t width,
+        uint8_t height,
+        uint8_t difficulty,
+        uint16_t* num_mines,
+        uint64_t* seed) {
+
+    furi_assert(board);
+    furi_assert(num_mines);
+    furi_assert(seed);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+
+    const uint16_t record_size = mine_sweeper_board_pool_record_size(width, height);
+    int32_t count = mine_sweeper_board_pool_open(file, width, height, difficulty, false);
+    bool is_popped = false;
+
+    if (count > 0) {
+        const uint32_t offset = sizeof(MineSweeperBoardPoolHeader) + (count - 1) * record_size;
+
+        // Cut the record off the end so a board is never handed out twice
+        is_popped = storage_file_seek(file, offset, true) &&
+                    storage_file_read(file, pool_record, record_size) == record_size &&
+                    storage_file_seek(file, offset, true) &&
+                    storage_file_truncate(file);
+    }
+
+    storage_file_close(file);
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    if (is_popped) {
+        memcpy(seed, pool_record, sizeof(*seed));
+        *num_mines = unpack_board_mines(board, width, height, pool_record + sizeof(*seed));
+    }
+
+    return is_popped;
+}
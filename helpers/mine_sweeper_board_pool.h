@@ -0,0 +1,40 @@
+#ifndef MINESWEEPER_BOARD_POOL_H
+#define MINESWEEPER_BOARD_POOL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "../views/minesweeper_engine.h"
+
+/** Pool of verified boards kept on the SD card, one file per width, height and difficulty.
+ *  Each file is a short header followed by fixed size records of the board seed and
+ *  one bit per tile for the mines. Boards are pushed to and popped from the end of the file.
+ *  The pool is not locked, only one thread should use it at a time.
+ */
+
+#define MINESWEEPER_BOARD_POOL_CAPACITY 16
+
+uint16_t mine_sweeper_board_pool_count(uint8_t width, uint8_t height, uint8_t difficulty);
+
+// Returns false if the pool is full, the file cannot be written or is_canceled was set.
+// is_canceled is checked right before every write to the card so a caller on another thread can stop it
+// between writes, NULL if the push cannot be canceled
+bool mine_sweeper_board_pool_push(
+        const MineSweeperTile* board,
+        uint8_t width,
+        uint8_t height,
+        uint8_t difficulty,
+        uint64_t seed,
+        const volatile bool* is_canceled);
+
+// Returns false if the pool is empty, otherwise board is rebuilt with every tile uncleared
+bool mine_sweeper_board_pool_pop(
+        MineSweeperTile* board,
+        uint8_t width,
+        uint8_t height,
+        uint8_t difficulty,
+        uint16_t* num_mines,
+        uint64_t* seed);
+
+
+#endif
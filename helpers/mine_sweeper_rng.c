@@ -0,0 +1,68 @@
+#include "mine_sweeper_rng.h"
+
+#include <furi_hal.h>
+
+static inline uint32_t rotl(const uint32_t x, int k) {
+    return (x << k) | (x >> (32 - k));
+}
+
+// splitmix64 is used to spread the 64 bit seed over the 128 bit state
+static inline uint64_t splitmix64(uint64_t* x) {
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+uint64_t mine_sweeper_rng_entropy_seed(void) {
+    uint64_t seed = 0;
+    furi_hal_random_fill_buf((uint8_t*)&seed, sizeof(seed));
+    return seed;
+}
+
+void mine_sweeper_rng_seed(MineSweeperRng* rng, uint64_t seed) {
+    furi_assert(rng);
+
+    uint64_t x = seed;
+    uint64_t a = splitmix64(&x);
+    uint64_t b = splitmix64(&x);
+
+    rng->s[0] = (uint32_t)a;
+    rng->s[1] = (uint32_t)(a >> 32);
+    rng->s[2] = (uint32_t)b;
+    rng->s[3] = (uint32_t)(b >> 32);
+
+    // The all zero state is the one state xoshiro can never leave
+    if ((rng->s[0] | rng->s[1] | rng->s[2] | rng->s[3]) == 0) {
+        rng->s[0] = 1;
+    }
+}
+
+uint32_t mine_sweeper_rng_next(MineSweeperRng* rng) {
+    furi_assert(rng);
+
+    uint32_t* s = rng->s;
+    const uint32_t result = rotl(s[1] * 5, 7) * 9;
+    const uint32_t t = s[1] << 9;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+
+    s[2] ^= t;
+
+    s[3] = rotl(s[3], 11);
+
+    return result;
+}
+
+uint64_t mine_sweeper_rng_next64(MineSweeperRng* rng) {
+    uint64_t hi = mine_sweeper_rng_next(rng);
+    return (hi << 32) | mine_sweeper_rng_next(rng);
+}
+
+uint32_t mine_sweeper_rng_range(MineSweeperRng* rng, uint32_t bound) {
+    // Multiply-shift range reduction, avoids the division of a modulo
+    return (uint32_t)(((uint64_t)mine_sweeper_rng_next(rng) * bound) >> 32);
+}
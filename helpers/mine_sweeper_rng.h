@@ -0,0 +1,27 @@
+#ifndef MINESWEEPER_RNG_H
+#define MINESWEEPER_RNG_H
+
+#include <stdint.h>
+
+/** Software PRNG (xoshiro128**) used for board generation.
+ *  The hardware RNG is only read once to produce a seed, after that
+ *  every draw is a few register ops and a given seed always produces
+ *  the same sequence.
+ */
+typedef struct {
+    uint32_t s[4];
+} MineSweeperRng;
+
+uint64_t mine_sweeper_rng_entropy_seed(void);
+
+void mine_sweeper_rng_seed(MineSweeperRng* rng, uint64_t seed);
+
+uint32_t mine_sweeper_rng_next(MineSweeperRng* rng);
+
+uint64_t mine_sweeper_rng_next64(MineSweeperRng* rng);
+
+// Returns a value in [0, bound)
+uint32_t mine_sweeper_rng_range(MineSweeperRng* rng, uint32_t bound);
+
+
+#endif
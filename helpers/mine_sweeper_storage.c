@@ -58,7 +58,10 @@ void mine_sweeper_save_settings(void* context) {
              d =  app->settings_info.difficulty,
              f =  app->feedback_enabled,
              wr = app->wrap_enabled,
-             s =  app->ensure_map_solvable ? 1 : 0;
+             s =  app->ensure_map_solvable ? 1 : 0,
+             fm = app->first_move_enabled,
+             b =  app->band_3bv,
+             l =  app->band_logic;
 
     flipper_format_write_uint32(
         fff_file, MINESWEEPER_SETTINGS_KEY_WIDTH, &w, 1);
@@ -72,6 +75,12 @@ void mine_sweeper_save_settings(void* context) {
         fff_file, MINESWEEPER_SETTINGS_KEY_WRAP, &wr, 1);
     flipper_format_write_uint32(
         fff_file, MINESWEEPER_SETTINGS_KEY_SOLVABLE, &s, 1);
+    flipper_format_write_uint32(
+        fff_file, MINESWEEPER_SETTINGS_KEY_FIRST_MOVE, &fm, 1);
+    flipper_format_write_uint32(
+        fff_file, MINESWEEPER_SETTINGS_KEY_3BV_BAND, &b, 1);
+    flipper_format_write_uint32(
+        fff_file, MINESWEEPER_SETTINGS_KEY_LOGIC_BAND, &l, 1);
     
     if(!flipper_format_rewind(fff_file)) {
         FURI_LOG_E(TAG, "Rewind error");
@@ -123,13 +132,16 @@ bool mine_sweeper_read_settings(void* context) {
         return false;
     }
 
-    uint32_t w = 7, h = 16, d = 0, f = 1, wr = 1, s = 0;
+    uint32_t w = 7, h = 16, d = 0, f = 1, wr = 1, s = 0, fm = 0, b = 0, l = 0;
     flipper_format_read_uint32(fff_file, MINESWEEPER_SETTINGS_KEY_WIDTH, &w, 1);
     flipper_format_read_uint32(fff_file, MINESWEEPER_SETTINGS_KEY_HEIGHT, &h, 1);
     flipper_format_read_uint32(fff_file, MINESWEEPER_SETTINGS_KEY_DIFFICULTY, &d, 1);
     flipper_format_read_uint32(fff_file, MINESWEEPER_SETTINGS_KEY_FEEDBACK, &f, 1);
     flipper_format_read_uint32(fff_file, MINESWEEPER_SETTINGS_KEY_WRAP, &wr, 1);
     flipper_format_read_uint32(fff_file, MINESWEEPER_SETTINGS_KEY_SOLVABLE, &s, 1);
+    flipper_format_read_uint32(fff_file, MINESWEEPER_SETTINGS_KEY_FIRST_MOVE, &fm, 1);
+    flipper_format_read_uint32(fff_file, MINESWEEPER_SETTINGS_KEY_3BV_BAND, &b, 1);
+    flipper_format_read_uint32(fff_file, MINESWEEPER_SETTINGS_KEY_LOGIC_BAND, &l, 1);
 
     w  = clamp(16, 32, w);
     h  = clamp(7, 32, h);
@@ -137,6 +149,9 @@ bool mine_sweeper_read_settings(void* context) {
     f  = clamp(0, 1, f);
     wr = clamp(0, 1, wr);
     s  = clamp(0, 1, s);
+    fm = clamp(0, 1, fm);
+    b  = clamp(0, MineSweeper3bvBandCount - 1, b);
+    l  = clamp(0, MineSweeperLogicBandCount - 1, l);
 
     app->settings_info.board_width = (uint8_t) w;
     app->settings_info.board_height = (uint8_t) h;
@@ -144,6 +159,9 @@ bool mine_sweeper_read_settings(void* context) {
     app->feedback_enabled = (uint8_t) f;
     app->wrap_enabled = (uint8_t) wr;
     app->ensure_map_solvable = s == 1 ? true : false;
+    app->first_move_enabled = (uint8_t) fm;
+    app->band_3bv = (uint8_t) b;
+    app->band_logic = (uint8_t) l;
 
     flipper_format_rewind(fff_file);
 
@@ -19,6 +19,9 @@
 #define MINESWEEPER_SETTINGS_KEY_FEEDBACK "FeedbackEnabled"
 #define MINESWEEPER_SETTINGS_KEY_WRAP "WrapEnabled"
 #define MINESWEEPER_SETTINGS_KEY_SOLVABLE "EnsureSolvable"
+#define MINESWEEPER_SETTINGS_KEY_FIRST_MOVE "FirstMoveGeneration"
+#define MINESWEEPER_SETTINGS_KEY_3BV_BAND "Board3bvBand"
+#define MINESWEEPER_SETTINGS_KEY_LOGIC_BAND "BoardLogicBand"
 
 void mine_sweeper_save_settings(void* context);
 bool mine_sweeper_read_settings(void* context);
@@ -54,6 +54,9 @@ static MineSweeperApp* app_alloc() {
         app->settings_info.difficulty = 0;
         app->feedback_enabled = 1;
         app->wrap_enabled = 1;
+        app->first_move_enabled = 0;
+        app->band_3bv = MineSweeper3bvBandAny;
+        app->band_logic = MineSweeperLogicBandAny;
 
         mine_sweeper_save_settings(app);
     } else {
@@ -68,15 +71,23 @@ static MineSweeperApp* app_alloc() {
             MineSweeperStartScreenView,
             start_screen_get_view(app->start_screen));
 
-    app->loading = loading_alloc();
-    view_dispatcher_add_view(app->view_dispatcher, MineSweeperLoadingView, loading_get_view(app->loading));
+    app->progress_screen = mine_sweeper_progress_screen_alloc();
+    view_dispatcher_add_view(
+        app->view_dispatcher,
+        MineSweeperProgressView,
+        mine_sweeper_progress_screen_get_view(app->progress_screen));
 
     app->game_screen = mine_sweeper_game_screen_alloc(
             app->settings_info.board_width,
             app->settings_info.board_height,
             app->settings_info.difficulty,
             false,
-            app->wrap_enabled);
+            app->wrap_enabled,
+            app->first_move_enabled);
+
+    // The first board is generated without a band like it is without the verifier, so the app starts at once
+    mine_sweeper_game_screen_set_3bv_band(app->game_screen, app->band_3bv);
+    mine_sweeper_game_screen_set_logic_band(app->game_screen, app->band_logic);
 
     view_dispatcher_add_view(
         app->view_dispatcher,
@@ -120,7 +131,7 @@ static void app_free(MineSweeperApp* app) {
     view_dispatcher_free(app->view_dispatcher);
 
     // Free views
-    loading_free(app->loading);
+    mine_sweeper_progress_screen_free(app->progress_screen);
     start_screen_free(app->start_screen);
     mine_sweeper_game_screen_free(app->game_screen);  
     dialog_ex_free(app->menu_screen);
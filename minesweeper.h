@@ -13,7 +13,6 @@
 #include <gui/gui.h>
 #include <gui/view_dispatcher.h>
 #include <gui/scene_manager.h>
-#include <gui/modules/loading.h>
 #include <gui/modules/dialog_ex.h>
 #include <gui/modules/variable_item_list.h>
 #include <gui/modules/text_box.h>
@@ -21,6 +20,7 @@
 #include "scenes/minesweeper_scene.h"
 #include "views/start_screen.h"
 #include "views/minesweeper_game_screen.h"
+#include "views/minesweeper_progress_screen.h"
 #include "helpers/mine_sweeper_storage.h"
 #include "minesweeper_redux_icons.h"
 
@@ -46,7 +46,7 @@ typedef struct MineSweeperApp {
     NotificationApp* notification;
 
     StartScreen* start_screen;
-    Loading* loading;
+    MineSweeperProgressScreen* progress_screen;
     MineSweeperGameScreen* game_screen;
     DialogEx* menu_screen;
     VariableItemList* settings_screen;
@@ -61,12 +61,15 @@ typedef struct MineSweeperApp {
 
     uint8_t feedback_enabled;
     uint8_t wrap_enabled;
+    uint8_t first_move_enabled;
+    uint8_t band_3bv;               // MineSweeper3bvBand
+    uint8_t band_logic;             // MineSweeperLogicBand
 } MineSweeperApp;
 
 // View Id Enumeration
 typedef enum {
     MineSweeperStartScreenView,
-    MineSweeperLoadingView,
+    MineSweeperProgressView,
     MineSweeperGameScreenView,
     MineSweeperMenuView,
     MineSweeperSettingsView,
@@ -75,6 +78,18 @@ typedef enum {
     MineSweeperViewCount,
 } MineSweeperView;
 
+// Custom events that cross scenes, kept clear of the per scene event enumerations
+typedef enum {
+    MineSweeperEventGenerationProgress = 100,
+    MineSweeperEventWaitForBoard,
+} MineSweeperEvent;
+
+// Where the generating scene was opened from, stored as its scene state
+typedef enum {
+    MineSweeperGeneratingSourceSettings,
+    MineSweeperGeneratingSourceGame,
+} MineSweeperGeneratingSource;
+
 // Enumerations for hardware states
 // Will be used in later implementation
 typedef enum {
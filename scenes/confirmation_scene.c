@@ -11,8 +11,6 @@ void minesweeper_scene_confirmation_screen_on_enter(void* context) {
     furi_assert(context);
     MineSweeperApp* app = (MineSweeperApp*)context;
 
-    view_dispatcher_switch_to_view(app->view_dispatcher, MineSweeperLoadingView);
-    
     dialog_ex_set_context(app->confirmation_screen, app);
 
     dialog_ex_set_header(app->confirmation_screen, "Save Settings?", 128/2, 4, AlignCenter, AlignTop);
@@ -50,32 +48,13 @@ bool minesweeper_scene_confirmation_screen_on_event(void* context, SceneManagerE
 
             case DialogExResultRight : 
 
-                view_dispatcher_switch_to_view(app->view_dispatcher, MineSweeperLoadingView);
-
-                // Commit changes to actual buffer for settings data
-                app->settings_info.board_width  = app->t_settings_info.board_width;
-                app->settings_info.board_height = app->t_settings_info.board_height;
-                app->settings_info.difficulty   = app->t_settings_info.difficulty;
-                app->settings_info.ensure_solvable_board = app->t_settings_info.ensure_solvable_board;
-
-                mine_sweeper_save_settings(app);
-
-                // This is used to let the settings view know it can save the main settings_info
-                // to the temp one on the next on enter
-                app->is_settings_changed = false;
-
-                mine_sweeper_led_reset(app);
+                // Settings are only committed once the board for them is generated
+                scene_manager_set_scene_state(
+                        app->scene_manager,
+                        MineSweeperSceneGeneratingScreen,
+                        MineSweeperGeneratingSourceSettings);
 
-                // Reset the game board
-                mine_sweeper_game_screen_reset(
-                        app->game_screen,
-                        app->settings_info.board_width,
-                        app->settings_info.board_height,
-                        app->settings_info.difficulty,
-                        app->settings_info.ensure_solvable_board);
-
-                // Go to reset game view
-                scene_manager_search_and_switch_to_another_scene(app->scene_manager, MineSweeperSceneGameScreen); 
+                scene_manager_next_scene(app->scene_manager, MineSweeperSceneGeneratingScreen);
                 break;
 
             case DialogExResultCenter :
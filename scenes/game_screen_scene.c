@@ -3,6 +3,13 @@
 
 #include <input/input.h>
 
+static void minesweeper_scene_game_screen_wait_callback(void* context) {
+    furi_assert(context);
+
+    MineSweeperApp* app = context;
+    view_dispatcher_send_custom_event(app->view_dispatcher, MineSweeperEventWaitForBoard);
+}
+
 void minesweeper_scene_game_screen_on_enter(void* context) {
     furi_assert(context);
     MineSweeperApp* app = context;
@@ -10,6 +17,7 @@ void minesweeper_scene_game_screen_on_enter(void* context) {
     furi_assert(app->game_screen);
 
     mine_sweeper_game_screen_set_context(app->game_screen, app);
+    mine_sweeper_game_screen_set_wait_callback(app->game_screen, minesweeper_scene_game_screen_wait_callback);
 
     view_dispatcher_switch_to_view(app->view_dispatcher, MineSweeperGameScreenView);
 }
@@ -20,9 +28,18 @@ bool minesweeper_scene_game_screen_on_event(void* context, SceneManagerEvent eve
     MineSweeperApp* app = context;
     bool consumed = false;
 
-    // No custom scene events from mine sweeper view
-    // Just check for back button to route to next screen
-    if (event.type == SceneManagerEventTypeBack) {
+    // The only custom event is the game having to wait on board generation, ticks refill the pool while the player is idle
+    if (event.type == SceneManagerEventTypeCustom && event.event == MineSweeperEventWaitForBoard) {
+        scene_manager_set_scene_state(
+                app->scene_manager,
+                MineSweeperSceneGeneratingScreen,
+                MineSweeperGeneratingSourceGame);
+
+        scene_manager_next_scene(app->scene_manager, MineSweeperSceneGeneratingScreen);
+        consumed = true;
+    } else if (event.type == SceneManagerEventTypeTick) {
+        mine_sweeper_game_screen_refill_when_idle(app->game_screen);
+    } else if (event.type == SceneManagerEventTypeBack) {
         scene_manager_next_scene(app->scene_manager, MineSweeperSceneMenuScreen);
         consumed = true;
     }
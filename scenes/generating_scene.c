@@ -0,0 +1,133 @@
+#include "../minesweeper.h"
+
+// Comes from the board generator worker thread, the custom event queue hands it to the GUI thread
+static void minesweeper_generating_scene_progress_callback(
+        const MineSweeperBoardGeneratorProgress* progress,
+        void* context) {
+
+    furi_assert(context);
+    UNUSED(progress);
+
+    MineSweeperApp* app = context;
+    view_dispatcher_send_custom_event(app->view_dispatcher, MineSweeperEventGenerationProgress);
+}
+
+// With first move generation new settings only need an empty game, the board is generated later
+static bool minesweeper_generating_scene_is_board_deferred(MineSweeperApp* app) {
+    uint32_t source = scene_manager_get_scene_state(app->scene_manager, MineSweeperSceneGeneratingScreen);
+
+    return source == MineSweeperGeneratingSourceSettings && app->first_move_enabled;
+}
+
+static void minesweeper_generating_scene_finish(MineSweeperApp* app) {
+    furi_assert(app);
+
+    // Stop progress events before the next board starts generating in the background
+    mine_sweeper_game_screen_set_generation_callback(app->game_screen, NULL, NULL);
+
+    uint32_t source = scene_manager_get_scene_state(app->scene_manager, MineSweeperSceneGeneratingScreen);
+
+    if (source == MineSweeperGeneratingSourceSettings) {
+        // Commit changes to actual buffer for settings data
+        app->settings_info.board_width  = app->t_settings_info.board_width;
+        app->settings_info.board_height = app->t_settings_info.board_height;
+        app->settings_info.difficulty   = app->t_settings_info.difficulty;
+        app->settings_info.ensure_solvable_board = app->t_settings_info.ensure_solvable_board;
+
+        mine_sweeper_save_settings(app);
+
+        // This is used to let the settings view know it can save the main settings_info
+        // to the temp one on the next on enter
+        app->is_settings_changed = false;
+    }
+
+    mine_sweeper_led_reset(app);
+
+    if (minesweeper_generating_scene_is_board_deferred(app)) {
+        mine_sweeper_game_screen_reset(
+                app->game_screen,
+                app->settings_info.board_width,
+                app->settings_info.board_height,
+                app->settings_info.difficulty,
+                app->settings_info.ensure_solvable_board);
+    } else {
+        furi_check(mine_sweeper_game_screen_apply_prepared_board(app->game_screen));
+    }
+
+    // Go to reset game view
+    scene_manager_search_and_switch_to_another_scene(app->scene_manager, MineSweeperSceneGameScreen);
+}
+
+void minesweeper_scene_generating_screen_on_enter(void* context) {
+    furi_assert(context);
+    MineSweeperApp* app = context;
+
+    mine_sweeper_progress_screen_reset(app->progress_screen);
+
+    mine_sweeper_game_screen_set_generation_callback(
+            app->game_screen,
+            minesweeper_generating_scene_progress_callback,
+            app);
+
+    uint32_t source = scene_manager_get_scene_state(app->scene_manager, MineSweeperSceneGeneratingScreen);
+
+    // The game starts its own job before it asks to wait on it
+    if (source == MineSweeperGeneratingSourceSettings && !minesweeper_generating_scene_is_board_deferred(app)) {
+        mine_sweeper_game_screen_prepare(
+                app->game_screen,
+                app->t_settings_info.board_width,
+                app->t_settings_info.board_height,
+                app->t_settings_info.difficulty,
+                app->t_settings_info.ensure_solvable_board);
+    }
+
+    view_dispatcher_switch_to_view(app->view_dispatcher, MineSweeperProgressView);
+
+    // The job may have finished before the callback was set
+    view_dispatcher_send_custom_event(app->view_dispatcher, MineSweeperEventGenerationProgress);
+}
+
+bool minesweeper_scene_generating_screen_on_event(void* context, SceneManagerEvent event) {
+    furi_assert(context);
+
+    MineSweeperApp* app = context;
+    bool consumed = false;
+
+    if (event.type == SceneManagerEventTypeCustom && event.event == MineSweeperEventGenerationProgress) {
+        MineSweeperBoardGeneratorProgress progress =
+            mine_sweeper_game_screen_get_generation_progress(app->game_screen);
+
+        if (progress.state == MineSweeperBoardGeneratorStateDone || minesweeper_generating_scene_is_board_deferred(app)) {
+            minesweeper_generating_scene_finish(app);
+        } else {
+            mine_sweeper_progress_screen_set_progress(app->progress_screen, &progress);
+        }
+
+        consumed = true;
+
+    } else if (event.type == SceneManagerEventTypeBack) {
+        mine_sweeper_game_screen_cancel_generation(app->game_screen);
+
+        uint32_t source = scene_manager_get_scene_state(app->scene_manager, MineSweeperSceneGeneratingScreen);
+
+        // Settings go back to be adjusted, the game goes back to where it was waiting
+        MineSweeperScene previous_scene = (source == MineSweeperGeneratingSourceSettings) ?
+            MineSweeperSceneSettingsScreen : MineSweeperSceneGameScreen;
+
+        if (!scene_manager_search_and_switch_to_previous_scene(app->scene_manager, previous_scene)) {
+            scene_manager_stop(app->scene_manager);
+            view_dispatcher_stop(app->view_dispatcher);
+        }
+
+        consumed = true;
+    }
+
+    return consumed;
+}
+
+void minesweeper_scene_generating_screen_on_exit(void* context) {
+    furi_assert(context);
+    MineSweeperApp* app = context;
+
+    mine_sweeper_game_screen_set_generation_callback(app->game_screen, NULL, NULL);
+}
@@ -35,15 +35,35 @@ static const char* info_string= "--   GAME INFO BELOW   --\n\n"
                                 "overhead when generating\n"
                                 "a new map. It can take\n"
                                 "several seconds for a\n"
-                                "valid map to generate. The\n"
-                                "UI may hang and stop for a\n"
-                                "while but it should resolve\n"
-                                "in a few seconds.\n\n"
+                                "valid map to generate. A\n"
+                                "progress screen is shown\n"
+                                "while you wait and Back\n"
+                                "cancels it.\n\n"
                                 "-----       WRAP       -----\n"
                                 "Enables wrapping player\n"
                                 "position to the other side\n"
                                 "of the screen if you move out\n"
                                 "of bounds.\n\n"
+                                "---   START ANYWHERE   ---\n"
+                                "The board is generated on\n"
+                                "your first press of OK so\n"
+                                "that tile always opens up\n"
+                                "an empty area. Without it\n"
+                                "the corners are the safe\n"
+                                "places to start.\n\n"
+                                "-------      3BV      -------\n"
+                                "The clicks a board takes\n"
+                                "to clear. Low and High only\n"
+                                "keep boards below or above\n"
+                                "the usual count for the\n"
+                                "size and difficulty.\n\n"
+                                "------     LOGIC     ------\n"
+                                "Simple keeps boards where\n"
+                                "every tile follows from a\n"
+                                "single number. Subsets\n"
+                                "keeps boards that need two\n"
+                                "numbers read together.\n"
+                                "Both verify every board.\n\n"
                                 "Enjoy the game and if you\n"
                                 "want to reach out about an\n"
                                 "issue go to the git hub repo\n"
@@ -34,8 +34,6 @@ void minesweeper_scene_menu_screen_on_enter(void* context) {
     furi_assert(context);
     MineSweeperApp* app = (MineSweeperApp*)context;
 
-    view_dispatcher_switch_to_view(app->view_dispatcher, MineSweeperLoadingView);
-    
     dialog_ex_set_context(app->menu_screen, app);
 
     dialog_ex_set_header(app->menu_screen, "Exit Game?", (128*3)/4, 4, AlignCenter, AlignTop);
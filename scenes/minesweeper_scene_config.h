@@ -3,4 +3,5 @@ ADD_SCENE(minesweeper, game_screen, GameScreen)
 ADD_SCENE(minesweeper, menu_screen, MenuScreen)
 ADD_SCENE(minesweeper, settings_screen, SettingsScreen)
 ADD_SCENE(minesweeper, confirmation_screen, ConfirmationScreen)
+ADD_SCENE(minesweeper, generating_screen, GeneratingScreen)
 ADD_SCENE(minesweeper, info_screen, InfoScreen)
@@ -23,6 +23,9 @@ typedef enum {
     MineSweeperSettingsScreenEventInfoChange,
     MineSweeperSettingsScreenEventFeedbackChange,
     MineSweeperSettingsScreenEventWrapChange,
+    MineSweeperSettingsScreenEventFirstMoveChange,
+    MineSweeperSettingsScreenEvent3bvBandChange,
+    MineSweeperSettingsScreenEventLogicBandChange,
 } MineSweeperSettingsScreenEvent;
 
 static const char* settings_screen_difficulty_text[MineSweeperSettingsScreenDifficultyTypeNum] = {
@@ -36,6 +39,18 @@ static const char* settings_screen_verifier_text[2] = {
     "True",
 };
 
+static const char* settings_screen_3bv_band_text[MineSweeper3bvBandCount] = {
+    "Any",
+    "Low",
+    "High",
+};
+
+static const char* settings_screen_logic_band_text[MineSweeperLogicBandCount] = {
+    "Any",
+    "Simple",
+    "Subsets",
+};
+
 static void minesweeper_scene_settings_screen_set_difficulty(VariableItem* item) {
     furi_assert(item);
 
@@ -147,6 +162,50 @@ static void minesweeper_scene_settings_screen_set_wrap(VariableItem* item) {
     view_dispatcher_send_custom_event(app->view_dispatcher, MineSweeperSettingsScreenEventWrapChange);
 }
 
+static void minesweeper_scene_settings_screen_set_first_move(VariableItem* item) { 
+    furi_assert(item);
+
+    MineSweeperApp* app = variable_item_get_context(item);
+
+    uint8_t value = variable_item_get_current_value_index(item);
+
+    app->first_move_enabled = value;
+    
+    variable_item_set_current_value_text(
+            item,
+            ((value) ? "Enabled" : "Disabled"));
+
+    view_dispatcher_send_custom_event(app->view_dispatcher, MineSweeperSettingsScreenEventFirstMoveChange);
+}
+
+static void minesweeper_scene_settings_screen_set_3bv_band(VariableItem* item) { 
+    furi_assert(item);
+
+    MineSweeperApp* app = variable_item_get_context(item);
+
+    uint8_t value = variable_item_get_current_value_index(item);
+
+    app->band_3bv = value;
+    
+    variable_item_set_current_value_text(item, settings_screen_3bv_band_text[value]);
+
+    view_dispatcher_send_custom_event(app->view_dispatcher, MineSweeperSettingsScreenEvent3bvBandChange);
+}
+
+static void minesweeper_scene_settings_screen_set_logic_band(VariableItem* item) { 
+    furi_assert(item);
+
+    MineSweeperApp* app = variable_item_get_context(item);
+
+    uint8_t value = variable_item_get_current_value_index(item);
+
+    app->band_logic = value;
+    
+    variable_item_set_current_value_text(item, settings_screen_logic_band_text[value]);
+
+    view_dispatcher_send_custom_event(app->view_dispatcher, MineSweeperSettingsScreenEventLogicBandChange);
+}
+
 static void minesweeper_scene_settings_screen_set_info(VariableItem* item) {
     furi_assert(item);
 
@@ -284,6 +343,54 @@ void minesweeper_scene_settings_screen_on_enter(void* context) {
             item,
             ((app->wrap_enabled) ? "Enabled" : "Disabled"));
     
+    // Set first move item 
+    item = variable_item_list_add(
+            va,
+            "Start Anywhere",
+            2,
+            minesweeper_scene_settings_screen_set_first_move,
+            app);
+
+    variable_item_set_current_value_index(
+            item,
+            app->first_move_enabled);
+
+    variable_item_set_current_value_text(
+            item,
+            ((app->first_move_enabled) ? "Enabled" : "Disabled"));
+    
+    // Set 3BV band item 
+    item = variable_item_list_add(
+            va,
+            "3BV",
+            MineSweeper3bvBandCount,
+            minesweeper_scene_settings_screen_set_3bv_band,
+            app);
+
+    variable_item_set_current_value_index(
+            item,
+            app->band_3bv);
+
+    variable_item_set_current_value_text(
+            item,
+            settings_screen_3bv_band_text[app->band_3bv]);
+    
+    // Set logic band item 
+    item = variable_item_list_add(
+            va,
+            "Logic",
+            MineSweeperLogicBandCount,
+            minesweeper_scene_settings_screen_set_logic_band,
+            app);
+
+    variable_item_set_current_value_index(
+            item,
+            app->band_logic);
+
+    variable_item_set_current_value_text(
+            item,
+            settings_screen_logic_band_text[app->band_logic]);
+    
     // Set info item
     item = variable_item_list_add(
             va,
@@ -344,6 +451,21 @@ bool minesweeper_scene_settings_screen_on_event(void* context, SceneManagerEvent
                 mine_sweeper_game_screen_set_wrap_enable(app->game_screen, app->wrap_enabled);
                 break;
 
+            case MineSweeperSettingsScreenEventFirstMoveChange : 
+                mine_sweeper_save_settings(app);
+                mine_sweeper_game_screen_set_first_move_enable(app->game_screen, app->first_move_enabled);
+                break;
+
+            case MineSweeperSettingsScreenEvent3bvBandChange : 
+                mine_sweeper_save_settings(app);
+                mine_sweeper_game_screen_set_3bv_band(app->game_screen, app->band_3bv);
+                break;
+
+            case MineSweeperSettingsScreenEventLogicBandChange : 
+                mine_sweeper_save_settings(app);
+                mine_sweeper_game_screen_set_logic_band(app->game_screen, app->band_logic);
+                break;
+
             case MineSweeperSettingsScreenEventFeedbackChange : 
                 mine_sweeper_save_settings(app);
                 break;
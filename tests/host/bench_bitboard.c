@@ -0,0 +1,229 @@
+// The bit plane engine against the tile array engine on the largest board: numbering a board from its mines,
+// flooding a board of only zeros, the first click of a game, a chord, and checking for a win.
+// Built with MINESWEEPER_ENGINE_BITBOARD, see run.sh
+
+#include "host.h"
+#include "views/minesweeper_bitboard.h"
+
+#define BENCH_BOARD_WIDTH  MINESWEEPER_BOARD_MAX_WIDTH
+#define BENCH_BOARD_HEIGHT MINESWEEPER_BOARD_MAX_HEIGHT
+#define BENCH_CLICKS       200
+
+static MineSweeperTile board[HOST_BOARD_STORAGE];
+static MineSweeperTile fresh[HOST_BOARD_STORAGE];
+static uint8_t mine_bits[MINESWEEPER_BOARD_MINE_BITS_SIZE(BENCH_BOARD_WIDTH, BENCH_BOARD_HEIGHT)];
+static uint32_t mines[MINESWEEPER_BITBOARD_MAX_ROW_WORDS * BENCH_BOARD_HEIGHT];
+static HostBoardState state;
+
+static const size_t board_size =
+        sizeof(MineSweeperTile) * MINESWEEPER_BOARD_STORAGE_SIZE(BENCH_BOARD_WIDTH, BENCH_BOARD_HEIGHT);
+
+static uint16_t click_tiles(const uint8_t x, const uint8_t y) {
+    return bfs_tile_clear(board, &state.geometry, &state.visited, &state.queue, &state.uncleared, x, y);
+}
+
+static uint16_t click_planes(const uint8_t x, const uint8_t y) {
+    return bitboard_tile_clear(board, &state.geometry, &state.uncleared, x, y);
+}
+
+static uint16_t chord_tiles(const uint8_t x, const uint8_t y) {
+    bool is_mine_cleared;
+    return chord_tile_clear(board, &state.geometry, &state.visited, &state.queue, &state.uncleared, x, y, &is_mine_cleared);
+}
+
+static uint16_t chord_planes(const uint8_t x, const uint8_t y) {
+    bool is_mine_cleared;
+    return bitboard_chord_clear(board, &state.geometry, &state.uncleared, x, y, &is_mine_cleared);
+}
+
+// Puts the fresh board back before every click, only the click itself is timed
+static double time_clicks(uint16_t (*click)(const uint8_t, const uint8_t), uint16_t* cleared) {
+    double best = 0;
+
+    for (uint8_t run = 0; run < HOST_BENCH_RUNS; run++) {
+        double total = 0;
+
+        for (uint16_t k = 0; k < BENCH_CLICKS; k++) {
+            memcpy(board, fresh, board_size);
+            reset_uncleared_index(&state.uncleared, board, &state.geometry);
+
+            const double start = host_now_us();
+
+            *cleared = click(BENCH_BOARD_HEIGHT / 2, BENCH_BOARD_WIDTH / 2);
+
+            total += host_now_us() - start;
+        }
+
+        best = host_best_us(best, total / BENCH_CLICKS);
+    }
+
+    return best;
+}
+
+// Chords every numbered tile of the frontier of the fresh board, flags are left out so mines go off too
+static double time_chords(uint16_t (*chord)(const uint8_t, const uint8_t), uint32_t* chords) {
+    const uint16_t stride = MINESWEEPER_BOARD_STRIDE(BENCH_BOARD_WIDTH);
+    double best = 0;
+
+    for (uint8_t run = 0; run < HOST_BENCH_RUNS; run++) {
+        memcpy(board, fresh, board_size);
+        reset_uncleared_index(&state.uncleared, board, &state.geometry);
+        *chords = 0;
+
+        const double start = host_now_us();
+
+        for (uint16_t pos_1d = get_next_frontier_tile(&state.uncleared, 0); pos_1d != 0;
+            pos_1d = get_next_frontier_tile(&state.uncleared, pos_1d + 1)) {
+            chord(pos_1d / stride - 1, pos_1d % stride - 1);
+            (*chords)++;
+        }
+
+        best = host_best_us(best, *chords ? (host_now_us() - start) / *chords : 0);
+    }
+
+    return best;
+}
+
+// What the win check of the tile array would cost without its counters, one look at every tile
+static bool is_board_solved(void) {
+    for (uint8_t x = 0; x < BENCH_BOARD_HEIGHT; x++) {
+        for (uint8_t y = 0; y < BENCH_BOARD_WIDTH; y++) {
+            const MineSweeperTile tile = board[get_board_index(BENCH_BOARD_WIDTH, x, y)];
+            const bool is_mine = tile.tile_type == MineSweeperGameScreenTileMine;
+
+            if (is_mine != (tile.tile_state == MineSweeperGameScreenTileStateFlagged) ||
+                (!is_mine && tile.tile_state != MineSweeperGameScreenTileStateCleared)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+int main(void) {
+    MineSweeperRng rng;
+    mine_sweeper_rng_seed(&rng, 3);
+
+    host_board_state_resize(&state, BENCH_BOARD_WIDTH, BENCH_BOARD_HEIGHT);
+
+    printf("bench_bitboard: %ux%u, tile array against bit planes\n", BENCH_BOARD_WIDTH, BENCH_BOARD_HEIGHT);
+
+    uint16_t cleared = 0;
+    double best;
+
+    // Numbering a hard board from its mines, one mine at a time into the tiles or with shifted adds of the plane
+    setup_board(board, BENCH_BOARD_WIDTH, BENCH_BOARD_HEIGHT, 2, NULL, &rng);
+    pack_board_mines(board, BENCH_BOARD_WIDTH, BENCH_BOARD_HEIGHT, mine_bits);
+
+    const uint8_t row_words = (BENCH_BOARD_WIDTH + 31) / 32;
+    uint16_t num_mines = 0;
+
+    for (uint16_t i = 0; i < BENCH_BOARD_WIDTH * BENCH_BOARD_HEIGHT; i++) {
+        if ((mine_bits[i >> 3] >> (i & 7)) & 1) {
+            set_plane_tile(mines, row_words, i / BENCH_BOARD_WIDTH, i % BENCH_BOARD_WIDTH, true);
+            num_mines++;
+        }
+    }
+
+    best = 0;
+
+    for (uint8_t run = 0; run < HOST_BENCH_RUNS; run++) {
+        const double start = host_now_us();
+
+        for (uint8_t k = 0; k < 100; k++) {
+            unpack_board_mines(board, BENCH_BOARD_WIDTH, BENCH_BOARD_HEIGHT, mine_bits);
+        }
+
+        best = host_best_us(best, (host_now_us() - start) / 100);
+    }
+
+    printf("%-34s %8.1f us %6u mines\n", "numbering, tiles", best, num_mines);
+
+    best = 0;
+
+    for (uint8_t run = 0; run < HOST_BENCH_RUNS; run++) {
+        const double start = host_now_us();
+
+        for (uint8_t k = 0; k < 100; k++) {
+            number_board_from_mines(mines, board, BENCH_BOARD_WIDTH, BENCH_BOARD_HEIGHT);
+        }
+
+        best = host_best_us(best, (host_now_us() - start) / 100);
+    }
+
+    printf("%-34s %8.1f us %6u mines\n", "numbering, planes", best, num_mines);
+
+    clear_board(fresh, BENCH_BOARD_WIDTH, BENCH_BOARD_HEIGHT, MineSweeperGameScreenTileZero);
+    best = time_clicks(click_tiles, &cleared);
+    printf("%-34s %8.1f us %6u tiles\n", "all zero board, tiles", best, cleared);
+    best = time_clicks(click_planes, &cleared);
+    printf("%-34s %8.1f us %6u tiles\n", "all zero board, planes", best, cleared);
+
+    // An easy board started from the middle, so the first click opens the zero region around it
+    const Point first_move = {.x = BENCH_BOARD_HEIGHT / 2, .y = BENCH_BOARD_WIDTH / 2};
+
+    setup_board(fresh, BENCH_BOARD_WIDTH, BENCH_BOARD_HEIGHT, 0, &first_move, &rng);
+    best = time_clicks(click_tiles, &cleared);
+    printf("%-34s %8.1f us %6u tiles\n", "first click, tiles", best, cleared);
+    best = time_clicks(click_planes, &cleared);
+    printf("%-34s %8.1f us %6u tiles\n", "first click, planes", best, cleared);
+
+    memcpy(board, fresh, board_size);
+    reset_uncleared_index(&state.uncleared, board, &state.geometry);
+    click_tiles(first_move.x, first_move.y);
+    memcpy(fresh, board, board_size);
+
+    uint32_t chords = 0;
+
+    best = time_chords(chord_tiles, &chords);
+    printf("%-34s %8.1f us %6lu chords\n", "chord along the frontier, tiles", best, (unsigned long)chords);
+    best = time_chords(chord_planes, &chords);
+    printf("%-34s %8.1f us %6lu chords\n", "chord along the frontier, planes", best, (unsigned long)chords);
+
+    // A won game, every mine flagged and everything else cleared, so neither check can stop early
+    for (uint8_t x = 0; x < BENCH_BOARD_HEIGHT; x++) {
+        for (uint8_t y = 0; y < BENCH_BOARD_WIDTH; y++) {
+            MineSweeperTile* tile = &board[get_board_index(BENCH_BOARD_WIDTH, x, y)];
+
+            tile->tile_state = (tile->tile_type == MineSweeperGameScreenTileMine) ? MineSweeperGameScreenTileStateFlagged :
+                                                                                    MineSweeperGameScreenTileStateCleared;
+        }
+    }
+
+    reset_uncleared_index(&state.uncleared, board, &state.geometry);
+
+    volatile bool is_solved = false;
+
+    best = 0;
+
+    for (uint8_t run = 0; run < HOST_BENCH_RUNS; run++) {
+        const double start = host_now_us();
+
+        for (uint16_t k = 0; k < 1000; k++) {
+            is_solved = is_board_solved();
+        }
+
+        best = host_best_us(best, (host_now_us() - start) / 1000);
+    }
+
+    printf("%-34s %8.3f us %6s\n", "win check, tile scan", best, is_solved ? "won" : "not won");
+
+    best = 0;
+
+    for (uint8_t run = 0; run < HOST_BENCH_RUNS; run++) {
+        const double start = host_now_us();
+
+        for (uint16_t k = 0; k < 1000; k++) {
+            is_solved = is_bitboard_solved(&state.uncleared);
+        }
+
+        best = host_best_us(best, (host_now_us() - start) / 1000);
+    }
+
+    printf("%-34s %8.3f us %6s\n", "win check, popcount", best, is_solved ? "won" : "not won");
+
+    host_board_state_free(&state);
+
+    return 0;
+}
@@ -0,0 +1,204 @@
+// setup_board against the mine placement it replaced, which drew random tiles until it hit one that
+// was neither a mine nor a reserved corner. Both number the board the same way, so only placement differs.
+// The placement columns time picking the mine positions alone, random draws included, which is the part
+// the partial Fisher-Yates shuffle changed. The board columns time the whole of setup_board.
+// On the host placement alone takes about as long either way; the shuffle only makes the number of
+// draws fixed, at num_mines, where the retry loop took 8-11% more.
+
+#include "host.h"
+
+static MineSweeperTile board[HOST_BOARD_STORAGE];
+
+// Positions picked by the placement loops, and the tiles the retry loop already put a mine on
+static uint16_t positions[HOST_BOARD_STORAGE];
+static bool is_mine[HOST_BOARD_STORAGE];
+
+static bool is_corner_position(const uint8_t board_width, const uint8_t board_height, const uint8_t x, const uint8_t y) {
+    return (x == 0 && y == 0) || (x == 0 && y == 1) || (x == 1 && y == 0) || (x == board_height - 1 && y == board_width - 1) ||
+           (x == 0 && y == board_width - 1) || (x == board_height - 1 && y == 0);
+}
+
+static uint16_t setup_board_retry_loop(
+        const MineSweeperBoardGeometry* geometry,
+        const uint8_t board_difficulty,
+        MineSweeperRng* rng) {
+
+    const uint8_t board_width = geometry->width;
+    const uint8_t board_height = geometry->height;
+    const uint16_t board_tile_count = board_width * board_height;
+    const uint16_t num_mines = get_board_mine_count(board_width, board_height, board_difficulty);
+
+    clear_board(board, board_width, board_height, MineSweeperGameScreenTileZero);
+
+    for (uint16_t i = 0; i < num_mines; i++) {
+        uint16_t pos_1d;
+        bool is_invalid_position;
+
+        do {
+            const uint16_t rand_pos = mine_sweeper_rng_next(rng) % board_tile_count;
+            const uint8_t x = rand_pos / board_width;
+            const uint8_t y = rand_pos % board_width;
+
+            pos_1d = get_board_index(board_width, x, y);
+            is_invalid_position = board[pos_1d].tile_type == MineSweeperGameScreenTileMine ||
+                                  is_corner_position(board_width, board_height, x, y);
+        } while (is_invalid_position);
+
+        board[pos_1d].tile_type = MineSweeperGameScreenTileMine;
+
+        for (uint8_t j = 0; j < 8; j++) {
+            MineSweeperTile* tile = &board[pos_1d + geometry->neighbor_offsets[j]];
+
+            if (tile->tile_type != MineSweeperGameScreenTileMine && tile->tile_state != MineSweeperGameScreenTileStateBorder) {
+                tile->tile_type++;
+            }
+        }
+    }
+
+    return num_mines;
+}
+
+// Picks num_mines positions the way the retry loop did, drawing again whenever it hits a mine or a corner
+static void place_mines_retry_loop(
+        const uint8_t board_width,
+        const uint8_t board_height,
+        const uint16_t num_mines,
+        MineSweeperRng* rng) {
+
+    const uint16_t board_tile_count = board_width * board_height;
+
+    memset(is_mine, 0, sizeof(bool) * board_tile_count);
+
+    for (uint16_t i = 0; i < num_mines; i++) {
+        uint16_t rand_pos;
+
+        do {
+            rand_pos = mine_sweeper_rng_next(rng) % board_tile_count;
+        } while (is_mine[rand_pos] || is_corner_position(board_width, board_height, rand_pos / board_width, rand_pos % board_width));
+
+        is_mine[rand_pos] = true;
+        positions[i] = rand_pos;
+    }
+}
+
+// Picks num_mines positions the way setup_board does, from a candidate list built without the corners
+static void place_mines_shuffle(
+        const uint8_t board_width,
+        const uint8_t board_height,
+        const uint16_t num_mines,
+        MineSweeperRng* rng) {
+
+    uint16_t candidate_count = 0;
+
+    // Like setup_board only the corner rows are checked, every other row is taken whole
+    for (uint8_t x = 0; x < board_height; x++) {
+        const bool has_reserved = x <= 1 || x == board_height - 1;
+
+        for (uint8_t y = 0; y < board_width; y++) {
+            if (!has_reserved || !is_corner_position(board_width, board_height, x, y)) {
+                positions[candidate_count++] = x * board_width + y;
+            }
+        }
+    }
+
+    for (uint16_t i = 0; i < num_mines; i++) {
+        const uint16_t j = i + mine_sweeper_rng_range(rng, candidate_count - i);
+        const uint16_t rand_pos = positions[j];
+
+        positions[j] = positions[i];
+        positions[i] = rand_pos;
+    }
+}
+
+// Counts the draws a board took by stepping a copy of the generator from where it started until it is
+// where the board left it, so both placements are measured the same way and outside of the timing
+static uint32_t count_draws(const MineSweeperRng* before, const MineSweeperRng* after) {
+    MineSweeperRng rng = *before;
+    uint32_t draws = 0;
+
+    while (memcmp(&rng, after, sizeof(rng)) != 0) {
+        mine_sweeper_rng_next(&rng);
+        draws++;
+    }
+
+    return draws;
+}
+
+int main(void) {
+    static const uint8_t sizes[][2] = {{16, 7}, {32, 32}, {146, 64}};
+    static const char* const difficulties[] = {"easy", "medium", "hard"};
+
+    MineSweeperRng rng;
+    mine_sweeper_rng_seed(&rng, 1);
+
+    printf("bench_setup_board: us per board, random draws per board\n");
+    printf("%-8s %-7s %6s %12s %12s %12s %12s %12s %12s\n", "size", "level", "mines", "place retry", "place shuf",
+           "board retry", "board shuf", "retry draws", "shuf draws");
+
+    for (uint8_t s = 0; s < COUNT_OF(sizes); s++) {
+        const uint8_t board_width = sizes[s][0];
+        const uint8_t board_height = sizes[s][1];
+        const uint16_t boards = 400000 / (board_width * board_height) + 50;
+
+        MineSweeperBoardGeometry geometry = {0};
+        set_board_geometry(&geometry, board_width, board_height);
+        furi_check(reserve_board_scratch(board_width, board_height));
+
+        for (uint8_t difficulty = 0; difficulty < COUNT_OF(difficulties); difficulty++) {
+            const uint16_t num_mines = get_board_mine_count(board_width, board_height, difficulty);
+            double place_retry_us = 0, place_shuffle_us = 0, retry_us = 0, shuffle_us = 0;
+
+            // Best of a few runs, each pair is run in turn so both see the same load
+            for (uint8_t run = 0; run < HOST_BENCH_RUNS; run++) {
+                double start = host_now_us();
+
+                for (uint16_t k = 0; k < boards; k++) {
+                    place_mines_retry_loop(board_width, board_height, num_mines, &rng);
+                }
+
+                place_retry_us = host_best_us(place_retry_us, (host_now_us() - start) / boards);
+                start = host_now_us();
+
+                for (uint16_t k = 0; k < boards; k++) {
+                    place_mines_shuffle(board_width, board_height, num_mines, &rng);
+                }
+
+                place_shuffle_us = host_best_us(place_shuffle_us, (host_now_us() - start) / boards);
+                start = host_now_us();
+
+                for (uint16_t k = 0; k < boards; k++) {
+                    setup_board_retry_loop(&geometry, difficulty, &rng);
+                }
+
+                retry_us = host_best_us(retry_us, (host_now_us() - start) / boards);
+                start = host_now_us();
+
+                for (uint16_t k = 0; k < boards; k++) {
+                    setup_board(board, board_width, board_height, difficulty, NULL, &rng);
+                }
+
+                shuffle_us = host_best_us(shuffle_us, (host_now_us() - start) / boards);
+            }
+
+            uint32_t retry_draws = 0, shuffle_draws = 0;
+
+            for (uint16_t k = 0; k < boards; k++) {
+                MineSweeperRng before = rng;
+                setup_board_retry_loop(&geometry, difficulty, &rng);
+                retry_draws += count_draws(&before, &rng);
+
+                before = rng;
+                setup_board(board, board_width, board_height, difficulty, NULL, &rng);
+                shuffle_draws += count_draws(&before, &rng);
+            }
+
+            printf("%3ux%-4u %-7s %6u %12.1f %12.1f %12.1f %12.1f %12.1f %12.1f\n", board_width, board_height,
+                   difficulties[difficulty], num_mines, place_retry_us, place_shuffle_us, retry_us, shuffle_us,
+                   (double)retry_draws / boards, (double)shuffle_draws / boards);
+        }
+    }
+
+    free_board_scratch();
+
+    return 0;
+}
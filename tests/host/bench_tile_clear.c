@@ -0,0 +1,122 @@
+// What a click costs on the largest board: flooding a board of only zeros, the first click of a game,
+// a chord, and finding the closest uncleared tile
+
+#include "host.h"
+
+#define BENCH_BOARD_WIDTH  MINESWEEPER_BOARD_MAX_WIDTH
+#define BENCH_BOARD_HEIGHT MINESWEEPER_BOARD_MAX_HEIGHT
+#define BENCH_CLICKS       200
+
+static MineSweeperTile board[HOST_BOARD_STORAGE];
+static MineSweeperTile fresh[HOST_BOARD_STORAGE];
+static HostBoardState state;
+
+static const size_t board_size =
+        sizeof(MineSweeperTile) * MINESWEEPER_BOARD_STORAGE_SIZE(BENCH_BOARD_WIDTH, BENCH_BOARD_HEIGHT);
+
+// Puts the fresh board back before every click, only the click itself is timed
+static double time_clicks(uint16_t* cleared) {
+    const uint8_t x = BENCH_BOARD_HEIGHT / 2;
+    const uint8_t y = BENCH_BOARD_WIDTH / 2;
+    double best = 0;
+
+    for (uint8_t run = 0; run < HOST_BENCH_RUNS; run++) {
+        double total = 0;
+
+        for (uint16_t k = 0; k < BENCH_CLICKS; k++) {
+            memcpy(board, fresh, board_size);
+            reset_uncleared_index(&state.uncleared, board, &state.geometry);
+
+            const double start = host_now_us();
+
+            *cleared = bfs_tile_clear(board, &state.geometry, &state.visited, &state.queue, &state.uncleared, x, y);
+
+            total += host_now_us() - start;
+        }
+
+        best = host_best_us(best, total / BENCH_CLICKS);
+    }
+
+    return best;
+}
+
+int main(void) {
+    MineSweeperRng rng;
+    mine_sweeper_rng_seed(&rng, 3);
+
+    host_board_state_resize(&state, BENCH_BOARD_WIDTH, BENCH_BOARD_HEIGHT);
+
+    printf("bench_tile_clear: %ux%u, us per click\n", BENCH_BOARD_WIDTH, BENCH_BOARD_HEIGHT);
+
+    uint16_t cleared = 0;
+    double best;
+
+    clear_board(fresh, BENCH_BOARD_WIDTH, BENCH_BOARD_HEIGHT, MineSweeperGameScreenTileZero);
+    best = time_clicks(&cleared);
+    printf("%-34s %8.1f us %6u tiles\n", "all zero board, flood", best, cleared);
+
+    // An easy board started from the middle, so the first click opens the zero region around it
+    const Point first_move = {.x = BENCH_BOARD_HEIGHT / 2, .y = BENCH_BOARD_WIDTH / 2};
+
+    setup_board(fresh, BENCH_BOARD_WIDTH, BENCH_BOARD_HEIGHT, 0, &first_move, &rng);
+    best = time_clicks(&cleared);
+    printf("%-34s %8.1f us %6u tiles\n", "first click, flood", best, cleared);
+
+    // Chords on every numbered tile the first click opened, flags are left out so mines go off too
+    memcpy(board, fresh, board_size);
+    reset_uncleared_index(&state.uncleared, board, &state.geometry);
+    bfs_tile_clear(board, &state.geometry, &state.visited, &state.queue, &state.uncleared, first_move.x, first_move.y);
+    memcpy(fresh, board, board_size);
+
+    uint32_t chords = 0;
+
+    best = 0;
+
+    for (uint8_t run = 0; run < HOST_BENCH_RUNS; run++) {
+        memcpy(board, fresh, board_size);
+        reset_uncleared_index(&state.uncleared, board, &state.geometry);
+        chords = 0;
+
+        const double start = host_now_us();
+
+        for (uint16_t pos_1d = get_next_frontier_tile(&state.uncleared, 0); pos_1d != 0;
+            pos_1d = get_next_frontier_tile(&state.uncleared, pos_1d + 1)) {
+            const uint16_t stride = MINESWEEPER_BOARD_STRIDE(BENCH_BOARD_WIDTH);
+            bool is_mine_cleared;
+
+            chord_tile_clear(board, &state.geometry, &state.visited, &state.queue, &state.uncleared, pos_1d / stride - 1,
+                             pos_1d % stride - 1, &is_mine_cleared);
+            chords++;
+        }
+
+        best = host_best_us(best, chords ? (host_now_us() - start) / chords : 0);
+    }
+
+    printf("%-34s %8.1f us %6lu chords\n", "chord along the frontier", best, (unsigned long)chords);
+
+    // The closest tile from every tile of a board with about half of it cleared
+    setup_board(board, BENCH_BOARD_WIDTH, BENCH_BOARD_HEIGHT, 2, NULL, &rng);
+    host_scatter_states(board, BENCH_BOARD_WIDTH, BENCH_BOARD_HEIGHT, 10, &rng);
+    reset_uncleared_index(&state.uncleared, board, &state.geometry);
+
+    best = 0;
+
+    for (uint8_t run = 0; run < HOST_BENCH_RUNS; run++) {
+        const double start = host_now_us();
+        Point found;
+
+        for (uint8_t x = 0; x < BENCH_BOARD_HEIGHT; x++) {
+            for (uint8_t y = 0; y < BENCH_BOARD_WIDTH; y++) {
+                find_closest_uncleared_tile(&state.uncleared, x, y, &found);
+            }
+        }
+
+        best = host_best_us(best, (host_now_us() - start) / (BENCH_BOARD_WIDTH * BENCH_BOARD_HEIGHT));
+    }
+
+    printf("%-34s %8.3f us %6u uncleared\n", "closest uncleared tile", best, state.uncleared.count);
+
+    host_board_state_free(&state);
+
+    return 0;
+}
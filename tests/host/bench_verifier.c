@@ -0,0 +1,79 @@
+// What ensure solvable costs per board, with and without repairs, and what scoring the 3BV of the largest board costs
+
+#include "host.h"
+
+#define BENCH_BOARDS 300
+
+static MineSweeperTile boards[BENCH_BOARDS][MINESWEEPER_BOARD_STORAGE_SIZE(32, 32)];
+static MineSweeperTile board[HOST_BOARD_STORAGE];
+
+// Verifies copies of the same boards every run, so every run sees the same work
+static double time_verifier(const uint8_t board_width, const uint8_t board_height, const bool with_repairs, uint16_t* solved) {
+    const uint16_t num_mines = get_board_mine_count(board_width, board_height, 2);
+    double best = 0;
+
+    for (uint8_t run = 0; run < HOST_BENCH_RUNS; run++) {
+        MineSweeperRng rng;
+        mine_sweeper_rng_seed(&rng, 11);
+        *solved = 0;
+
+        const double start = host_now_us();
+
+        for (uint16_t k = 0; k < BENCH_BOARDS; k++) {
+            memcpy(board, boards[k], sizeof(boards[k]));
+            *solved += check_board_with_verifier(board, board_width, board_height, num_mines, NULL, with_repairs ? &rng : NULL, NULL);
+        }
+
+        best = host_best_us(best, (host_now_us() - start) / BENCH_BOARDS);
+    }
+
+    return best;
+}
+
+int main(void) {
+    const uint8_t board_width = 32, board_height = 32;
+
+    MineSweeperRng rng;
+    mine_sweeper_rng_seed(&rng, 9);
+
+    furi_check(reserve_board_scratch(board_width, board_height));
+
+    for (uint16_t k = 0; k < BENCH_BOARDS; k++) {
+        setup_board(boards[k], board_width, board_height, 2, NULL, &rng);
+    }
+
+    printf("bench_verifier: %u hard %ux%u boards\n", BENCH_BOARDS, board_width, board_height);
+
+    uint16_t solved;
+    double best;
+
+    best = time_verifier(board_width, board_height, false, &solved);
+    printf("%-30s %8.3f ms per board %4u solved\n", "verify only", best / 1000, solved);
+    best = time_verifier(board_width, board_height, true, &solved);
+    printf("%-30s %8.3f ms per board %4u solved\n", "verify with repairs", best / 1000, solved);
+
+    // The largest board, scored every time a game comes in
+    furi_check(reserve_board_scratch(MINESWEEPER_BOARD_MAX_WIDTH, MINESWEEPER_BOARD_MAX_HEIGHT));
+    setup_board(board, MINESWEEPER_BOARD_MAX_WIDTH, MINESWEEPER_BOARD_MAX_HEIGHT, 0, NULL, &rng);
+
+    uint16_t board_3bv = 0;
+
+    best = 0;
+
+    for (uint8_t run = 0; run < HOST_BENCH_RUNS; run++) {
+        const double start = host_now_us();
+
+        for (uint8_t k = 0; k < 100; k++) {
+            board_3bv = get_board_3bv(board, MINESWEEPER_BOARD_MAX_WIDTH, MINESWEEPER_BOARD_MAX_HEIGHT);
+        }
+
+        best = host_best_us(best, (host_now_us() - start) / 100);
+    }
+
+    printf("%-30s %8.1f us %ux%u easy board, 3BV %u\n", "get_board_3bv", best, MINESWEEPER_BOARD_MAX_WIDTH,
+           MINESWEEPER_BOARD_MAX_HEIGHT, board_3bv);
+
+    free_board_scratch();
+
+    return 0;
+}
@@ -0,0 +1,119 @@
+/**
+ * @file host.h
+ * Helpers shared by the host tests and benchmarks
+ *
+ * Everything here is built with the stand-in SDK in sdk/, see run.sh.
+ */
+
+#ifndef MINESWEEPER_HOST_H
+#define MINESWEEPER_HOST_H
+
+#include <stdio.h>
+#include <time.h>
+
+#include "views/minesweeper_engine.h"
+
+// Enough tiles for the largest board the settings allow, border ring included
+#define HOST_BOARD_STORAGE MINESWEEPER_BOARD_STORAGE_SIZE(MINESWEEPER_BOARD_MAX_WIDTH, MINESWEEPER_BOARD_MAX_HEIGHT)
+
+// Board sizes every test walks through, the odd ones catch off by one errors at the edges and word boundaries.
+// 16x12 and 24x8 have the same tile count but not the same size with the border ring, one after the other
+// they catch memory that is kept for a board of another shape
+static const uint8_t host_board_sizes[][2] = {
+    {16, 7}, {32, 32}, {146, 7}, {16, 64}, {146, 64}, {1, 1}, {3, 1}, {1, 5}, {33, 2}, {64, 3}, {16, 12}, {24, 8},
+};
+
+#define HOST_BOARD_SIZE_COUNT COUNT_OF(host_board_sizes)
+
+// Everything the game screen model keeps next to its board, sized like install_board does
+typedef struct {
+    MineSweeperBoardGeometry geometry;
+    MineSweeperVisitedSet visited;
+    MineSweeperTileQueue queue;
+    MineSweeperUnclearedIndex uncleared;
+} HostBoardState;
+
+static inline void host_board_state_resize(HostBoardState* state, const uint8_t board_width, const uint8_t board_height) {
+    set_board_geometry(&state->geometry, board_width, board_height);
+    furi_check(reserve_board_scratch(board_width, board_height));
+    furi_check(resize_visited_set(&state->visited, board_width, board_height));
+    furi_check(resize_tile_queue(&state->queue, board_width, board_height));
+    furi_check(resize_uncleared_index(&state->uncleared, board_width, board_height));
+}
+
+static inline void host_board_state_free(HostBoardState* state) {
+    free_visited_set(&state->visited);
+    free_tile_queue(&state->queue);
+    free_uncleared_index(&state->uncleared);
+    free_board_scratch();
+}
+
+// Counts a failed check and prints where it was, tests exit with the number of failures
+static int host_failures __attribute__((unused)) = 0;
+
+#define host_expect(condition, ...)                                  \
+    do {                                                             \
+        if (!(condition)) {                                          \
+            if (host_failures++ < 10) {                              \
+                printf("%s:%d: %s: ", __FILE__, __LINE__, #condition); \
+                printf(__VA_ARGS__);                                 \
+                printf("\n");                                        \
+            }                                                        \
+        }                                                            \
+    } while (0)
+
+static inline double host_now_us(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return now.tv_sec * 1e6 + now.tv_nsec / 1e3;
+}
+
+// Benchmarks keep the fastest of this many runs, which is the one least disturbed by the rest of the host
+#define HOST_BENCH_RUNS 5
+
+static inline double host_best_us(const double best, const double run) {
+    return (best == 0 || run < best) ? run : best;
+}
+
+static inline uint16_t host_count_state(
+        const MineSweeperTile* board,
+        const uint8_t board_width,
+        const uint8_t board_height,
+        const MineSweeperGameScreenTileState tile_state) {
+
+    uint16_t count = 0;
+
+    for (uint8_t x = 0; x < board_height; x++) {
+        for (uint8_t y = 0; y < board_width; y++) {
+            count += board[get_board_index(board_width, x, y)].tile_state == tile_state;
+        }
+    }
+
+    return count;
+}
+
+// Puts flags and cleared tiles on a fresh board the way a game in progress would have them,
+// mines are never cleared and about one tile in ten is changed for every step of density
+static inline void host_scatter_states(
+        MineSweeperTile* board,
+        const uint8_t board_width,
+        const uint8_t board_height,
+        const uint8_t density,
+        MineSweeperRng* rng) {
+
+    const uint16_t changes = board_width * board_height * density / 10;
+
+    for (uint16_t i = 0; i < changes; i++) {
+        const uint16_t tile = mine_sweeper_rng_range(rng, board_width * board_height);
+        MineSweeperTile* target = &board[get_board_index(board_width, tile / board_width, tile % board_width)];
+
+        if (i & 1) {
+            target->tile_state = MineSweeperGameScreenTileStateFlagged;
+        } else if (target->tile_type != MineSweeperGameScreenTileMine) {
+            target->tile_state = MineSweeperGameScreenTileStateCleared;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,67 @@
+#!/bin/sh
+# Builds the engine on the host against the stand-in SDK in sdk/ and runs the tests, then the benchmarks.
+# No Flipper toolchain is needed, only a C compiler:
+#
+#   tests/host/run.sh          tests and benchmarks
+#   tests/host/run.sh test     tests only, exits non-zero if one fails
+#   tests/host/run.sh bench    benchmarks only
+#
+# CC and CFLAGS are taken from the environment, e.g. CFLAGS="-O2 -DMINESWEEPER_STACK_AUDIT".
+# Tests are also built with TEST_CFLAGS, AddressSanitizer by default so reads and writes past a buffer fail the test.
+# Benchmark numbers are host numbers, they show relative changes and not the speed on the device.
+# test_bitboard and bench_bitboard are built with MINESWEEPER_ENGINE_BITBOARD, every other one without it.
+
+set -e
+
+HOST_DIR=$(cd "$(dirname "$0")" && pwd)
+ROOT_DIR=$(cd "$HOST_DIR/../.." && pwd)
+BUILD_DIR="$HOST_DIR/build"
+CC=${CC:-cc}
+CFLAGS=${CFLAGS:--O2 -g}
+TEST_CFLAGS=${TEST_CFLAGS:--fsanitize=address,undefined -fno-sanitize-recover=all -fno-omit-frame-pointer}
+
+TESTS="test_setup_board test_board_3bv test_tile_clear test_verifier test_board_pool test_bitboard test_engine_heap"
+BENCHES="bench_setup_board bench_tile_clear bench_verifier bench_bitboard"
+
+build() {
+    name=$1
+    flags=$2
+    shift 2
+
+    $CC $CFLAGS $flags -std=gnu17 -Wall -Wno-unused-function \
+        -I"$HOST_DIR/sdk" -I"$ROOT_DIR" -I"$ROOT_DIR/views" -I"$HOST_DIR" \
+        "$HOST_DIR/$name.c" "$HOST_DIR/sdk/sdk.c" \
+        "$ROOT_DIR/views/minesweeper_engine.c" "$ROOT_DIR/views/minesweeper_bitboard.c" \
+        "$ROOT_DIR/helpers/mine_sweeper_rng.c" "$@" \
+        -o "$BUILD_DIR/$name" -lm
+}
+
+# The engine the app plays on when MINESWEEPER_ENGINE_BITBOARD is added to its cdefines
+engine_flags() {
+    case $1 in
+        *_bitboard) echo "-DMINESWEEPER_ENGINE_BITBOARD" ;;
+    esac
+}
+
+mkdir -p "$BUILD_DIR"
+
+if [ "$1" != "bench" ]; then
+    for name in $TESTS; do
+        if [ "$name" = "test_board_pool" ]; then
+            build "$name" "$TEST_CFLAGS" "$ROOT_DIR/helpers/mine_sweeper_board_pool.c"
+        elif [ "$name" = "test_engine_heap" ]; then
+            build "$name" "$TEST_CFLAGS -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc,--wrap=free"
+        else
+            build "$name" "$TEST_CFLAGS $(engine_flags "$name")"
+        fi
+
+        (cd "$BUILD_DIR" && "./$name")
+    done
+fi
+
+if [ "$1" != "test" ]; then
+    for name in $BENCHES; do
+        build "$name" "$(engine_flags "$name")"
+        (cd "$BUILD_DIR" && "./$name")
+    done
+fi
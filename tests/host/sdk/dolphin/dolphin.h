@@ -0,0 +1,3 @@
+#pragma once
+typedef enum { DolphinDeedPluginGameStart, DolphinDeedPluginGameWin } DolphinDeed;
+void dolphin_deed(DolphinDeed);
@@ -0,0 +1,13 @@
+#pragma once
+#include <storage/storage.h>
+typedef struct FlipperFormat FlipperFormat;
+FlipperFormat* flipper_format_file_alloc(Storage*);
+void flipper_format_free(FlipperFormat*);
+bool flipper_format_file_open_new(FlipperFormat*, const char*);
+bool flipper_format_file_open_existing(FlipperFormat*, const char*);
+bool flipper_format_file_close(FlipperFormat*);
+bool flipper_format_rewind(FlipperFormat*);
+bool flipper_format_write_header_cstr(FlipperFormat*, const char*, uint32_t);
+bool flipper_format_read_header(FlipperFormat*, FuriString*, uint32_t*);
+bool flipper_format_write_uint32(FlipperFormat*, const char*, const uint32_t*, uint16_t);
+bool flipper_format_read_uint32(FlipperFormat*, const char*, uint32_t*, uint16_t);
@@ -0,0 +1,79 @@
+#pragma once
+// Host stand-in for the parts of the Flipper SDK the engine and its helpers use, see tests/host/run.sh
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <assert.h>
+#define furi_assert(x) assert(x)
+#define furi_check(x) assert(x)
+#define UNUSED(x) (void)(x)
+#define FURI_LOG_D(tag, fmt, ...) do { (void)(tag); if(0) printf(fmt, ##__VA_ARGS__); } while(0)
+#define FURI_LOG_I(tag, fmt, ...) do { (void)(tag); if(0) printf(fmt, ##__VA_ARGS__); } while(0)
+#define FURI_LOG_E(tag, fmt, ...) do { (void)(tag); if(0) printf(fmt, ##__VA_ARGS__); } while(0)
+#define FURI_LOG_W(tag, fmt, ...) do { (void)(tag); if(0) printf(fmt, ##__VA_ARGS__); } while(0)
+#define FURI_LOG_T(tag, fmt, ...) do { (void)(tag); if(0) printf(fmt, ##__VA_ARGS__); } while(0)
+#define EXT_PATH(x) "/ext/" x
+#define FuriWaitForever 0xFFFFFFFFU
+#define COUNT_OF(x) (sizeof(x)/sizeof(x[0]))
+#define MIN(a,b) ((a)<(b)?(a):(b))
+#define MAX(a,b) ((a)>(b)?(a):(b))
+typedef struct FuriString FuriString;
+FuriString* furi_string_alloc(void);
+void furi_string_free(FuriString*);
+void furi_string_printf(FuriString*, const char*, ...);
+void furi_string_set_strn(FuriString*, const char*, size_t);
+void furi_string_reset(FuriString*);
+const char* furi_string_get_cstr(const FuriString*);
+uint32_t furi_get_tick(void);
+uint32_t furi_kernel_get_tick_frequency(void);
+uint32_t furi_ms_to_ticks(uint32_t);
+void furi_delay_ms(uint32_t);
+void furi_delay_tick(uint32_t);
+void* furi_record_open(const char*);
+void furi_record_close(const char*);
+typedef enum { FuriStatusOk = 0, FuriStatusError = -1, FuriStatusErrorTimeout = -2 } FuriStatus;
+typedef struct FuriThread FuriThread;
+typedef int32_t (*FuriThreadCallback)(void* context);
+typedef enum { FuriThreadStateStopped, FuriThreadStateStarting, FuriThreadStateRunning } FuriThreadState;
+typedef enum { FuriThreadPriorityIdle = 0, FuriThreadPriorityLowest = 14, FuriThreadPriorityLow = 15, FuriThreadPriorityNormal = 16 } FuriThreadPriority;
+FuriThread* furi_thread_alloc(void);
+FuriThread* furi_thread_alloc_ex(const char* name, uint32_t stack_size, FuriThreadCallback cb, void* ctx);
+void furi_thread_free(FuriThread*);
+void furi_thread_set_name(FuriThread*, const char*);
+void furi_thread_set_stack_size(FuriThread*, size_t);
+void furi_thread_set_callback(FuriThread*, FuriThreadCallback);
+void furi_thread_set_context(FuriThread*, void*);
+void furi_thread_set_priority(FuriThread*, FuriThreadPriority);
+void furi_thread_start(FuriThread*);
+bool furi_thread_join(FuriThread*);
+FuriThreadState furi_thread_get_state(FuriThread*);
+typedef void* FuriThreadId;
+uint32_t furi_thread_get_stack_space(FuriThreadId thread_id);
+const char* furi_thread_get_name(FuriThreadId thread_id);
+void* furi_thread_get_current_id(void);
+void* furi_thread_get_id(FuriThread*);
+uint32_t furi_thread_flags_set(void* thread_id, uint32_t flags);
+uint32_t furi_thread_flags_wait(uint32_t flags, uint32_t options, uint32_t timeout);
+uint32_t furi_thread_flags_clear(uint32_t flags);
+#define FuriFlagWaitAny 0
+#define FuriFlagWaitAll 1
+#define FuriFlagNoClear 2
+#define FuriFlagError 0x80000000U
+typedef struct FuriMutex FuriMutex;
+typedef enum { FuriMutexTypeNormal, FuriMutexTypeRecursive } FuriMutexType;
+FuriMutex* furi_mutex_alloc(FuriMutexType);
+void furi_mutex_free(FuriMutex*);
+FuriStatus furi_mutex_acquire(FuriMutex*, uint32_t);
+FuriStatus furi_mutex_release(FuriMutex*);
+typedef struct FuriTimer FuriTimer;
+typedef void (*FuriTimerCallback)(void* context);
+typedef enum { FuriTimerTypeOnce, FuriTimerTypePeriodic } FuriTimerType;
+FuriTimer* furi_timer_alloc(FuriTimerCallback, FuriTimerType, void*);
+void furi_timer_free(FuriTimer*);
+FuriStatus furi_timer_start(FuriTimer*, uint32_t);
+FuriStatus furi_timer_stop(FuriTimer*);
+size_t memmgr_get_free_heap(void);
+size_t memmgr_heap_get_max_free_block(void);
@@ -0,0 +1,4 @@
+#pragma once
+#include <furi.h>
+uint32_t furi_hal_random_get(void);
+void furi_hal_random_fill_buf(uint8_t* buf, uint32_t len);
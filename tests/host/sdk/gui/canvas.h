@@ -0,0 +1,19 @@
+#pragma once
+#include <furi.h>
+typedef struct Canvas Canvas;
+typedef struct Icon Icon;
+typedef enum { ColorWhite, ColorBlack, ColorXOR } Color;
+typedef enum { AlignLeft, AlignRight, AlignTop, AlignBottom, AlignCenter } Align;
+typedef enum { FontPrimary, FontSecondary, FontKeyboard, FontBigNumbers } Font;
+void canvas_clear(Canvas*);
+void canvas_set_color(Canvas*, Color);
+void canvas_set_font(Canvas*, Font);
+void canvas_draw_icon(Canvas*, int32_t, int32_t, const Icon*);
+void canvas_draw_line(Canvas*, int32_t, int32_t, int32_t, int32_t);
+void canvas_draw_frame(Canvas*, int32_t, int32_t, size_t, size_t);
+void canvas_draw_box(Canvas*, int32_t, int32_t, size_t, size_t);
+void canvas_draw_str(Canvas*, int32_t, int32_t, const char*);
+void canvas_draw_str_aligned(Canvas*, int32_t, int32_t, Align, Align, const char*);
+uint16_t canvas_string_width(Canvas*, const char*);
+uint16_t icon_get_width(const Icon*);
+uint16_t icon_get_height(const Icon*);
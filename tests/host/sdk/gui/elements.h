@@ -0,0 +1,8 @@
+#pragma once
+#include <gui/canvas.h>
+void elements_progress_bar(Canvas*, int32_t, int32_t, size_t, float);
+void elements_progress_bar_with_text(Canvas*, int32_t, int32_t, size_t, float, const char*);
+void elements_button_left(Canvas*, const char*);
+void elements_button_center(Canvas*, const char*);
+void elements_button_right(Canvas*, const char*);
+void elements_multiline_text_aligned(Canvas*, int32_t, int32_t, Align, Align, const char*);
@@ -0,0 +1,4 @@
+#pragma once
+#include <gui/view.h>
+typedef struct Gui Gui;
+#define RECORD_GUI "gui"
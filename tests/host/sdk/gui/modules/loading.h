@@ -0,0 +1,6 @@
+#pragma once
+#include <gui/view.h>
+typedef struct Loading Loading;
+Loading* loading_alloc(void);
+void loading_free(Loading*);
+View* loading_get_view(Loading*);
@@ -0,0 +1,12 @@
+#pragma once
+#include <gui/view.h>
+typedef struct TextBox TextBox;
+typedef enum { TextBoxFontText, TextBoxFontHex } TextBoxFont;
+typedef enum { TextBoxFocusStart, TextBoxFocusEnd } TextBoxFocus;
+TextBox* text_box_alloc(void);
+void text_box_free(TextBox*);
+View* text_box_get_view(TextBox*);
+void text_box_reset(TextBox*);
+void text_box_set_text(TextBox*, const char*);
+void text_box_set_font(TextBox*, TextBoxFont);
+void text_box_set_focus(TextBox*, TextBoxFocus);
@@ -0,0 +1,14 @@
+#pragma once
+#include <gui/view.h>
+typedef struct VariableItemList VariableItemList;
+typedef struct VariableItem VariableItem;
+typedef void (*VariableItemChangeCallback)(VariableItem*);
+VariableItemList* variable_item_list_alloc(void);
+void variable_item_list_free(VariableItemList*);
+void variable_item_list_reset(VariableItemList*);
+View* variable_item_list_get_view(VariableItemList*);
+VariableItem* variable_item_list_add(VariableItemList*, const char*, uint8_t, VariableItemChangeCallback, void*);
+void variable_item_set_current_value_index(VariableItem*, uint8_t);
+void variable_item_set_current_value_text(VariableItem*, const char*);
+uint8_t variable_item_get_current_value_index(VariableItem*);
+void* variable_item_get_context(VariableItem*);
@@ -0,0 +1,22 @@
+#pragma once
+#include <furi.h>
+typedef enum { SceneManagerEventTypeCustom, SceneManagerEventTypeBack, SceneManagerEventTypeTick } SceneManagerEventType;
+typedef struct { SceneManagerEventType type; uint32_t event; } SceneManagerEvent;
+typedef void (*AppSceneOnEnterCallback)(void*);
+typedef bool (*AppSceneOnEventCallback)(void*, SceneManagerEvent);
+typedef void (*AppSceneOnExitCallback)(void*);
+typedef struct { const AppSceneOnEnterCallback* on_enter_handlers; const AppSceneOnEventCallback* on_event_handlers; const AppSceneOnExitCallback* on_exit_handlers; const uint32_t scene_num; } SceneManagerHandlers;
+typedef struct SceneManager SceneManager;
+void scene_manager_set_scene_state(SceneManager*, uint32_t, uint32_t);
+uint32_t scene_manager_get_scene_state(const SceneManager*, uint32_t);
+SceneManager* scene_manager_alloc(const SceneManagerHandlers*, void*);
+void scene_manager_free(SceneManager*);
+bool scene_manager_handle_custom_event(SceneManager*, uint32_t);
+bool scene_manager_handle_back_event(SceneManager*);
+void scene_manager_handle_tick_event(SceneManager*);
+void scene_manager_next_scene(SceneManager*, uint32_t);
+bool scene_manager_previous_scene(SceneManager*);
+bool scene_manager_search_and_switch_to_previous_scene(SceneManager*, uint32_t);
+bool scene_manager_search_and_switch_to_another_scene(SceneManager*, uint32_t);
+bool scene_manager_has_previous_scene(const SceneManager*, uint32_t);
+void scene_manager_stop(SceneManager*);
@@ -0,0 +1,32 @@
+#pragma once
+#include <furi.h>
+#include <input/input.h>
+#include <gui/canvas.h>
+typedef struct View View;
+typedef void (*ViewDrawCallback)(Canvas*, void*);
+typedef bool (*ViewInputCallback)(InputEvent*, void*);
+typedef bool (*ViewCustomCallback)(uint32_t, void*);
+typedef uint32_t (*ViewNavigationCallback)(void*);
+typedef void (*ViewCallback)(void*);
+typedef enum { ViewModelTypeNone, ViewModelTypeLockFree, ViewModelTypeLocking } ViewModelType;
+#define VIEW_NONE 0xFFFFFFFF
+#define VIEW_IGNORE 0xFFFFFFFE
+View* view_alloc(void);
+void view_free(View*);
+void view_set_context(View*, void*);
+void view_set_draw_callback(View*, ViewDrawCallback);
+void view_set_input_callback(View*, ViewInputCallback);
+void view_set_custom_callback(View*, ViewCustomCallback);
+void view_set_previous_callback(View*, ViewNavigationCallback);
+void view_set_enter_callback(View*, ViewCallback);
+void view_set_exit_callback(View*, ViewCallback);
+void view_allocate_model(View*, ViewModelType, size_t);
+void view_free_model(View*);
+void* view_get_model(View*);
+void view_commit_model(View*, bool);
+#define with_view_model(view, type, code, update) \
+    {                                             \
+        type = view_get_model(view);              \
+        {code};                                   \
+        view_commit_model(view, update);          \
+    }
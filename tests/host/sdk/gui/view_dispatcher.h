@@ -0,0 +1,22 @@
+#pragma once
+#include <gui/view.h>
+#include <gui/gui.h>
+typedef struct ViewDispatcher ViewDispatcher;
+typedef enum { ViewDispatcherTypeDesktop, ViewDispatcherTypeWindow, ViewDispatcherTypeFullscreen } ViewDispatcherType;
+typedef bool (*ViewDispatcherCustomEventCallback)(void*, uint32_t);
+typedef bool (*ViewDispatcherNavigationEventCallback)(void*);
+typedef void (*ViewDispatcherTickEventCallback)(void*);
+ViewDispatcher* view_dispatcher_alloc(void);
+void view_dispatcher_free(ViewDispatcher*);
+void view_dispatcher_enable_queue(ViewDispatcher*);
+void view_dispatcher_send_custom_event(ViewDispatcher*, uint32_t);
+void view_dispatcher_set_custom_event_callback(ViewDispatcher*, ViewDispatcherCustomEventCallback);
+void view_dispatcher_set_navigation_event_callback(ViewDispatcher*, ViewDispatcherNavigationEventCallback);
+void view_dispatcher_set_tick_event_callback(ViewDispatcher*, ViewDispatcherTickEventCallback, uint32_t);
+void view_dispatcher_set_event_callback_context(ViewDispatcher*, void*);
+void view_dispatcher_run(ViewDispatcher*);
+void view_dispatcher_stop(ViewDispatcher*);
+void view_dispatcher_add_view(ViewDispatcher*, uint32_t, View*);
+void view_dispatcher_remove_view(ViewDispatcher*, uint32_t);
+void view_dispatcher_switch_to_view(ViewDispatcher*, uint32_t);
+void view_dispatcher_attach_to_gui(ViewDispatcher*, Gui*, ViewDispatcherType);
@@ -0,0 +1,3 @@
+#pragma once
+#include <gui/canvas.h>
+extern const Icon I_tile_empty_8x8, I_tile_0_8x8, I_tile_1_8x8, I_tile_2_8x8, I_tile_3_8x8, I_tile_4_8x8, I_tile_5_8x8, I_tile_6_8x8, I_tile_7_8x8, I_tile_8_8x8, I_tile_mine_8x8, I_tile_flag_8x8, I_tile_uncleared_8x8, I_Cry_dolph_55x52, I_minesweeper, A_StartScreen_128x64;
@@ -0,0 +1,9 @@
+#pragma once
+#include <furi.h>
+typedef struct NotificationApp NotificationApp;
+typedef struct NotificationSequence NotificationSequence;
+typedef struct NotificationMessage NotificationMessage;
+#define RECORD_NOTIFICATION "notification"
+extern const NotificationSequence sequence_display_backlight_on, sequence_reset_rgb, sequence_blink_magenta_10, sequence_blink_cyan_10, sequence_blink_yellow_10, sequence_blink_red_10, sequence_single_vibro, sequence_double_vibro, sequence_reset_vibro, sequence_set_vibro_on;
+void notification_message(NotificationApp*, const NotificationSequence*);
+void notification_message_block(NotificationApp*, const NotificationSequence*);
@@ -0,0 +1,53 @@
+// Host stand-ins for the SDK functions the engine and the board rng link against
+
+#include <furi.h>
+#include <furi_hal.h>
+#include <gui/canvas.h>
+
+#include "minesweeper_redux_icons.h"
+
+struct Icon {
+    int unused;
+};
+
+const Icon I_tile_empty_8x8, I_tile_0_8x8, I_tile_1_8x8, I_tile_2_8x8, I_tile_3_8x8, I_tile_4_8x8, I_tile_5_8x8,
+    I_tile_6_8x8, I_tile_7_8x8, I_tile_8_8x8, I_tile_mine_8x8, I_tile_flag_8x8, I_tile_uncleared_8x8;
+
+uint32_t furi_hal_random_get(void) {
+    return (uint32_t)rand();
+}
+
+void furi_hal_random_fill_buf(uint8_t* buf, uint32_t len) {
+    for (uint32_t i = 0; i < len; i++) {
+        buf[i] = (uint8_t)rand();
+    }
+}
+
+// FREE_HEAP in the environment sets the free heap the memory budget checks see
+size_t memmgr_get_free_heap(void) {
+    const char* free_heap = getenv("FREE_HEAP");
+
+    return (free_heap != NULL) ? (size_t)atol(free_heap) : (size_t)1 << 30;
+}
+
+size_t memmgr_heap_get_max_free_block(void) {
+    return memmgr_get_free_heap();
+}
+
+void* furi_thread_get_current_id(void) {
+    static int host_thread;
+
+    return &host_thread;
+}
+
+const char* furi_thread_get_name(FuriThreadId thread_id) {
+    UNUSED(thread_id);
+
+    return "host";
+}
+
+uint32_t furi_thread_get_stack_space(FuriThreadId thread_id) {
+    UNUSED(thread_id);
+
+    return 1024;
+}
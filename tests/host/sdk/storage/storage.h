@@ -0,0 +1,25 @@
+#pragma once
+#include <furi.h>
+typedef struct Storage Storage;
+typedef struct File File;
+typedef struct FileInfo FileInfo;
+typedef enum { FSE_OK, FSE_NOT_READY, FSE_EXIST, FSE_NOT_EXIST } FS_Error;
+typedef enum { FSAM_READ = 1, FSAM_WRITE = 2, FSAM_READ_WRITE = 3 } FS_AccessMode;
+typedef enum { FSOM_OPEN_EXISTING = 1, FSOM_OPEN_ALWAYS = 2, FSOM_OPEN_APPEND = 4, FSOM_CREATE_NEW = 8, FSOM_CREATE_ALWAYS = 16 } FS_OpenMode;
+#define RECORD_STORAGE "storage"
+File* storage_file_alloc(Storage*);
+void storage_file_free(File*);
+bool storage_file_open(File*, const char*, FS_AccessMode, FS_OpenMode);
+bool storage_file_close(File*);
+size_t storage_file_read(File*, void*, size_t);
+size_t storage_file_write(File*, const void*, size_t);
+bool storage_file_seek(File*, uint32_t, bool);
+uint64_t storage_file_tell(File*);
+uint64_t storage_file_size(File*);
+bool storage_file_truncate(File*);
+bool storage_file_exists(Storage*, const char*);
+bool storage_simply_remove(Storage*, const char*);
+bool storage_simply_mkdir(Storage*, const char*);
+FS_Error storage_common_stat(Storage*, const char*, FileInfo*);
+FS_Error storage_common_rename(Storage*, const char*, const char*);
+FS_Error storage_common_remove(Storage*, const char*);
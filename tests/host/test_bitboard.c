@@ -0,0 +1,217 @@
+// The bit plane engine against the tile array engine: boards numbered from a mine plane, clicks, chords
+// and flags played on both side by side, and the popcount win check against the tiles along a whole game.
+// Built with MINESWEEPER_ENGINE_BITBOARD, see run.sh
+
+#include "host.h"
+#include "views/minesweeper_bitboard.h"
+
+static MineSweeperTile board[HOST_BOARD_STORAGE];
+static MineSweeperTile planes_board[HOST_BOARD_STORAGE];
+static MineSweeperTile fresh_board[HOST_BOARD_STORAGE];
+static uint8_t mine_bits[MINESWEEPER_BOARD_MINE_BITS_SIZE(MINESWEEPER_BOARD_MAX_WIDTH, MINESWEEPER_BOARD_MAX_HEIGHT)];
+static uint16_t order[MINESWEEPER_BOARD_MAX_TILES];
+static HostBoardState state;
+static MineSweeperUnclearedIndex planes;
+static MineSweeperUnclearedIndex fresh;
+
+// The planes of the live index have to match planes loaded from scratch, and no flood leaves a zero pending
+static void check_planes(const uint8_t board_width, const uint8_t board_height) {
+    const size_t plane_size = sizeof(uint32_t) * planes.row_words * board_height;
+
+    furi_check(resize_uncleared_index(&fresh, board_width, board_height));
+    reset_uncleared_index(&fresh, planes_board, &state.geometry);
+
+    host_expect(memcmp(planes.rows, fresh.rows, plane_size) == 0, "%ux%u rows", board_width, board_height);
+    host_expect(memcmp(planes.mines, fresh.mines, plane_size) == 0, "%ux%u mines", board_width, board_height);
+    host_expect(memcmp(planes.zeros, fresh.zeros, plane_size) == 0, "%ux%u zeros", board_width, board_height);
+    host_expect(memcmp(planes.flags, fresh.flags, plane_size) == 0, "%ux%u flags", board_width, board_height);
+    host_expect(memcmp(planes.pending, fresh.pending, plane_size) == 0, "%ux%u pending", board_width, board_height);
+    host_expect(planes.mine_count == fresh.mine_count, "%ux%u %u mines, %u from scratch", board_width, board_height,
+                planes.mine_count, fresh.mine_count);
+}
+
+// Both engines have to leave the same tiles and the same uncleared index behind
+static void check_engines(const uint8_t board_width, const uint8_t board_height, const uint8_t move, const uint8_t x, const uint8_t y) {
+    const uint16_t storage_size = MINESWEEPER_BOARD_STORAGE_SIZE(board_width, board_height);
+    const MineSweeperUnclearedIndex* tiles = &state.uncleared;
+
+    host_expect(memcmp(board, planes_board, sizeof(MineSweeperTile) * storage_size) == 0, "%ux%u move %u at %u,%u",
+                board_width, board_height, move, x, y);
+    host_expect(tiles->count == planes.count && tiles->frontier_count == planes.frontier_count, "%ux%u move %u at %u,%u",
+                board_width, board_height, move, x, y);
+    host_expect(memcmp(tiles->row_counts, planes.row_counts, board_height) == 0, "%ux%u row counts", board_width, board_height);
+
+    for (uint16_t pos_1d = get_next_frontier_tile(tiles, 0); pos_1d != 0; pos_1d = get_next_frontier_tile(tiles, pos_1d + 1)) {
+        host_expect(is_frontier_tile(&planes, pos_1d), "%ux%u frontier tile %u", board_width, board_height, pos_1d);
+    }
+
+    check_planes(board_width, board_height);
+}
+
+// Won when every mine is flagged and every other tile is cleared
+static bool is_reference_solved(const uint8_t board_width, const uint8_t board_height) {
+    for (uint8_t x = 0; x < board_height; x++) {
+        for (uint8_t y = 0; y < board_width; y++) {
+            const MineSweeperTile tile = planes_board[get_board_index(board_width, x, y)];
+            const bool is_mine = tile.tile_type == MineSweeperGameScreenTileMine;
+
+            if (is_mine != (tile.tile_state == MineSweeperGameScreenTileStateFlagged) ||
+                (!is_mine && tile.tile_state != MineSweeperGameScreenTileStateCleared)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+static void set_flag(const uint8_t board_width, const uint8_t x, const uint8_t y, const bool is_flagged) {
+    const uint16_t pos_1d = get_board_index(board_width, x, y);
+
+    planes_board[pos_1d].tile_state = is_flagged ? MineSweeperGameScreenTileStateFlagged : MineSweeperGameScreenTileStateUncleared;
+    update_uncleared_index(&planes, planes_board, pos_1d);
+}
+
+// Plays a board to a win in a random order, with a wrong flag now and then that is taken back at the end
+static void check_win(const uint8_t board_width, const uint8_t board_height, MineSweeperRng* rng, uint32_t* wins) {
+    const uint16_t board_tile_count = board_width * board_height;
+    uint16_t wrong_flags = 0;
+
+    reset_uncleared_index(&planes, planes_board, &state.geometry);
+
+    for (uint16_t i = 0; i < board_tile_count; i++) {
+        order[i] = i;
+    }
+
+    for (uint16_t i = 0; i < board_tile_count; i++) {
+        const uint16_t j = i + mine_sweeper_rng_range(rng, board_tile_count - i);
+        const uint16_t tile = order[j];
+        order[j] = order[i];
+        order[i] = tile;
+
+        const uint8_t x = tile / board_width;
+        const uint8_t y = tile % board_width;
+        const MineSweeperTile target = planes_board[get_board_index(board_width, x, y)];
+
+        if (target.tile_state != MineSweeperGameScreenTileStateUncleared) {
+            continue;
+        }
+
+        if (target.tile_type == MineSweeperGameScreenTileMine) {
+            set_flag(board_width, x, y, true);
+        } else if (mine_sweeper_rng_range(rng, 8) == 0) {
+            set_flag(board_width, x, y, true);
+            order[wrong_flags++] = tile;
+        } else {
+            bitboard_tile_clear(planes_board, &state.geometry, &planes, x, y);
+        }
+
+        host_expect(is_bitboard_solved(&planes) == is_reference_solved(board_width, board_height), "%ux%u step %u",
+                    board_width, board_height, i);
+    }
+
+    for (uint16_t i = 0; i < wrong_flags; i++) {
+        const uint8_t x = order[i] / board_width;
+        const uint8_t y = order[i] % board_width;
+
+        set_flag(board_width, x, y, false);
+        host_expect(!is_bitboard_solved(&planes), "%ux%u wrong flag %u,%u taken back", board_width, board_height, x, y);
+
+        bitboard_tile_clear(planes_board, &state.geometry, &planes, x, y);
+    }
+
+    host_expect(is_bitboard_solved(&planes) && is_reference_solved(board_width, board_height), "%ux%u played to the end",
+                board_width, board_height);
+
+    *wins += is_bitboard_solved(&planes);
+}
+
+int main(void) {
+    MineSweeperRng rng;
+    mine_sweeper_rng_seed(&rng, 13);
+
+    uint32_t moves = 0, wins = 0;
+
+    for (uint16_t k = 0; k < 600; k++) {
+        const uint8_t board_width = host_board_sizes[k % HOST_BOARD_SIZE_COUNT][0];
+        const uint8_t board_height = host_board_sizes[k % HOST_BOARD_SIZE_COUNT][1];
+        const uint16_t storage_size = MINESWEEPER_BOARD_STORAGE_SIZE(board_width, board_height);
+
+        host_board_state_resize(&state, board_width, board_height);
+        furi_check(resize_uncleared_index(&planes, board_width, board_height));
+
+        // Numbered from the mine plane by setup_board, and again one mine at a time from the same layout
+        setup_board(planes_board, board_width, board_height, k % 3, NULL, &rng);
+        pack_board_mines(planes_board, board_width, board_height, mine_bits);
+        unpack_board_mines(board, board_width, board_height, mine_bits);
+
+        host_expect(memcmp(board, planes_board, sizeof(MineSweeperTile) * storage_size) == 0, "%ux%u numbering",
+                    board_width, board_height);
+
+        memcpy(fresh_board, board, sizeof(MineSweeperTile) * storage_size);
+
+        host_scatter_states(board, board_width, board_height, k % 4, &rng);
+        memcpy(planes_board, board, sizeof(MineSweeperTile) * storage_size);
+        reset_uncleared_index(&state.uncleared, board, &state.geometry);
+        reset_uncleared_index(&planes, planes_board, &state.geometry);
+
+        for (uint8_t n = 0; n < 100; n++) {
+            const uint16_t tile = mine_sweeper_rng_range(&rng, board_width * board_height);
+            const uint8_t x = tile / board_width;
+            const uint8_t y = tile % board_width;
+            const uint16_t pos_1d = get_board_index(board_width, x, y);
+            const uint8_t move = mine_sweeper_rng_range(&rng, 3);
+
+            uint16_t cleared = 0, planes_cleared = 0;
+
+            if (move == 0 && board[pos_1d].tile_type != MineSweeperGameScreenTileMine) {
+                cleared = bfs_tile_clear(board, &state.geometry, &state.visited, &state.queue, &state.uncleared, x, y);
+                planes_cleared = bitboard_tile_clear(planes_board, &state.geometry, &planes, x, y);
+
+            } else if (move == 1) {
+                bool is_mine_cleared = false;
+                bool is_planes_mine_cleared = false;
+
+                cleared = chord_tile_clear(
+                        board, &state.geometry, &state.visited, &state.queue, &state.uncleared, x, y, &is_mine_cleared);
+                planes_cleared = bitboard_chord_clear(planes_board, &state.geometry, &planes, x, y, &is_planes_mine_cleared);
+
+                host_expect(is_mine_cleared == is_planes_mine_cleared, "%ux%u chord at %u,%u", board_width, board_height, x, y);
+
+            } else if (move == 2 && board[pos_1d].tile_state != MineSweeperGameScreenTileStateCleared) {
+                const bool is_flagged = board[pos_1d].tile_state != MineSweeperGameScreenTileStateFlagged;
+
+                board[pos_1d].tile_state =
+                        is_flagged ? MineSweeperGameScreenTileStateFlagged : MineSweeperGameScreenTileStateUncleared;
+                update_uncleared_index(&state.uncleared, board, pos_1d);
+                set_flag(board_width, x, y, is_flagged);
+            }
+
+            moves++;
+
+            host_expect(cleared == planes_cleared, "%ux%u move %u at %u,%u cleared %u, on planes %u", board_width,
+                        board_height, move, x, y, cleared, planes_cleared);
+            check_engines(board_width, board_height, move, x, y);
+
+            if (host_failures > 0) {
+                break;
+            }
+        }
+
+        memcpy(planes_board, fresh_board, sizeof(MineSweeperTile) * storage_size);
+        check_win(board_width, board_height, &rng, &wins);
+
+        if (host_failures > 0) {
+            break;
+        }
+    }
+
+    free_uncleared_index(&planes);
+    free_uncleared_index(&fresh);
+    host_board_state_free(&state);
+
+    printf("test_bitboard: %d failures over %lu moves, %lu games won\n", host_failures, (unsigned long)moves,
+           (unsigned long)wins);
+
+    return host_failures != 0;
+}
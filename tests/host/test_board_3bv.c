@@ -0,0 +1,58 @@
+// get_board_3bv and get_live_board_3bv against clicking through a copy of the board
+
+#include "host.h"
+
+static MineSweeperTile board[HOST_BOARD_STORAGE];
+static MineSweeperTile played[HOST_BOARD_STORAGE];
+static HostBoardState state;
+
+// Clicks every zero region that is still closed, then every numbered tile that is still closed
+static uint16_t count_clicks(const uint8_t board_width, const uint8_t board_height) {
+    memcpy(played, board, sizeof(MineSweeperTile) * MINESWEEPER_BOARD_STORAGE_SIZE(board_width, board_height));
+    reset_uncleared_index(&state.uncleared, played, &state.geometry);
+
+    uint16_t clicks = 0;
+
+    for (uint8_t pass = 0; pass < 2; pass++) {
+        for (uint8_t x = 0; x < board_height; x++) {
+            for (uint8_t y = 0; y < board_width; y++) {
+                const MineSweeperTile tile = played[get_board_index(board_width, x, y)];
+
+                if (tile.tile_state != MineSweeperGameScreenTileStateUncleared || tile.tile_type == MineSweeperGameScreenTileMine ||
+                    (pass == 0 && tile.tile_type != MineSweeperGameScreenTileZero)) {
+                    continue;
+                }
+
+                bfs_tile_clear(played, &state.geometry, &state.visited, &state.queue, &state.uncleared, x, y);
+                clicks++;
+            }
+        }
+    }
+
+    return clicks;
+}
+
+int main(void) {
+    MineSweeperRng rng;
+    mine_sweeper_rng_seed(&rng, 99);
+
+    for (uint16_t k = 0; k < 2000; k++) {
+        const uint8_t board_width = host_board_sizes[k % HOST_BOARD_SIZE_COUNT][0];
+        const uint8_t board_height = host_board_sizes[k % HOST_BOARD_SIZE_COUNT][1];
+
+        host_board_state_resize(&state, board_width, board_height);
+        setup_board(board, board_width, board_height, k % 3, NULL, &rng);
+
+        const uint16_t board_3bv = get_board_3bv(board, board_width, board_height);
+
+        host_expect(board_3bv == count_clicks(board_width, board_height), "%ux%u board %u", board_width, board_height, k);
+        host_expect(board_3bv == get_live_board_3bv(board, &state.geometry, &state.visited, &state.queue), "%ux%u board %u",
+                    board_width, board_height, k);
+    }
+
+    host_board_state_free(&state);
+
+    printf("test_board_3bv: %d failures\n", host_failures);
+
+    return host_failures != 0;
+}
@@ -0,0 +1,219 @@
+// Board pool push and pop round trip, with the SD card stood in for by files under sd/ in the build directory
+
+#include <errno.h>
+#include <stdarg.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "host.h"
+#include "helpers/mine_sweeper_board_pool.h"
+#include "helpers/mine_sweeper_storage.h"
+
+#define HOST_SD_ROOT "sd"
+
+struct FuriString {
+    char text[256];
+};
+
+struct File {
+    FILE* stream;
+};
+
+FuriString* furi_string_alloc(void) {
+    return calloc(1, sizeof(FuriString));
+}
+
+void furi_string_free(FuriString* string) {
+    free(string);
+}
+
+const char* furi_string_get_cstr(const FuriString* string) {
+    return string->text;
+}
+
+void furi_string_printf(FuriString* string, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    vsnprintf(string->text, sizeof(string->text), format, args);
+    va_end(args);
+}
+
+void* furi_record_open(const char* name) {
+    UNUSED(name);
+
+    return NULL;
+}
+
+void furi_record_close(const char* name) {
+    UNUSED(name);
+}
+
+static const char* get_host_path(const char* path) {
+    static char host_path[320];
+    snprintf(host_path, sizeof(host_path), HOST_SD_ROOT "%s", path);
+
+    return host_path;
+}
+
+File* storage_file_alloc(Storage* storage) {
+    UNUSED(storage);
+
+    return calloc(1, sizeof(File));
+}
+
+void storage_file_free(File* file) {
+    free(file);
+}
+
+bool storage_file_open(File* file, const char* path, FS_AccessMode access_mode, FS_OpenMode open_mode) {
+    UNUSED(access_mode);
+
+    file->stream = fopen(get_host_path(path), "r+b");
+
+    if (file->stream == NULL && open_mode == FSOM_OPEN_ALWAYS) {
+        file->stream = fopen(get_host_path(path), "w+b");
+    }
+
+    return file->stream != NULL;
+}
+
+bool storage_file_close(File* file) {
+    if (file->stream != NULL) {
+        fclose(file->stream);
+    }
+
+    file->stream = NULL;
+
+    return true;
+}
+
+size_t storage_file_read(File* file, void* buff, size_t bytes_to_read) {
+    return fread(buff, 1, bytes_to_read, file->stream);
+}
+
+size_t storage_file_write(File* file, const void* buff, size_t bytes_to_write) {
+    return fwrite(buff, 1, bytes_to_write, file->stream);
+}
+
+bool storage_file_seek(File* file, uint32_t offset, bool from_start) {
+    return fseek(file->stream, offset, from_start ? SEEK_SET : SEEK_CUR) == 0;
+}
+
+uint64_t storage_file_size(File* file) {
+    const long position = ftell(file->stream);
+    fseek(file->stream, 0, SEEK_END);
+    const long size = ftell(file->stream);
+    fseek(file->stream, position, SEEK_SET);
+
+    return size;
+}
+
+bool storage_file_truncate(File* file) {
+    fflush(file->stream);
+
+    return ftruncate(fileno(file->stream), ftell(file->stream)) == 0;
+}
+
+FS_Error storage_common_stat(Storage* storage, const char* path, FileInfo* fileinfo) {
+    UNUSED(storage);
+    UNUSED(fileinfo);
+
+    struct stat host_stat;
+
+    return (stat(get_host_path(path), &host_stat) == 0) ? FSE_OK : FSE_NOT_EXIST;
+}
+
+// Makes the parent directories as well, the SD card already has /ext/apps_data
+bool storage_simply_mkdir(Storage* storage, const char* path) {
+    UNUSED(storage);
+
+    char host_path[320];
+    snprintf(host_path, sizeof(host_path), "%s", get_host_path(path));
+
+    for (char* slash = strchr(host_path, '/'); slash != NULL; slash = strchr(slash + 1, '/')) {
+        *slash = '\0';
+        mkdir(host_path, 0755);
+        *slash = '/';
+    }
+
+    return mkdir(host_path, 0755) == 0 || errno == EEXIST;
+}
+
+static MineSweeperTile board[HOST_BOARD_STORAGE];
+static MineSweeperTile popped[HOST_BOARD_STORAGE];
+static MineSweeperTile pushed[MINESWEEPER_BOARD_POOL_CAPACITY][HOST_BOARD_STORAGE];
+
+int main(void) {
+    const uint8_t board_width = 31, board_height = 29, difficulty = 2;
+    const size_t board_size = sizeof(MineSweeperTile) * MINESWEEPER_BOARD_STORAGE_SIZE(board_width, board_height);
+
+    MineSweeperRng rng;
+    mine_sweeper_rng_seed(&rng, 5);
+
+    furi_check(reserve_board_scratch(board_width, board_height));
+
+    // Start from an empty card, a pool left over from an earlier run would be popped first
+    char pool_path[400];
+    snprintf(pool_path, sizeof(pool_path), "%s/board_pool_%ux%u_%u.bin", get_host_path(CONFIG_FILE_DIRECTORY_PATH), board_width,
+             board_height, difficulty);
+    unlink(pool_path);
+
+    host_expect(mine_sweeper_board_pool_count(board_width, board_height, difficulty) == 0, "pool is not empty");
+
+    // Pushing past the capacity is refused
+    for (uint8_t k = 0; k < MINESWEEPER_BOARD_POOL_CAPACITY + 4; k++) {
+        setup_board(board, board_width, board_height, difficulty, NULL, &rng);
+
+        const bool is_pushed = mine_sweeper_board_pool_push(board, board_width, board_height, difficulty, k * 1000 + 7, NULL);
+
+        host_expect(is_pushed == (k < MINESWEEPER_BOARD_POOL_CAPACITY), "push %u", k);
+
+        if (is_pushed) {
+            memcpy(pushed[k], board, board_size);
+        }
+    }
+
+    host_expect(mine_sweeper_board_pool_count(board_width, board_height, difficulty) == MINESWEEPER_BOARD_POOL_CAPACITY,
+                "pool holds %u boards", mine_sweeper_board_pool_count(board_width, board_height, difficulty));
+
+    // Boards come back last in, first out
+    for (int8_t k = MINESWEEPER_BOARD_POOL_CAPACITY - 1; k >= 0; k--) {
+        uint16_t num_mines = 0;
+        uint64_t seed = 0;
+
+        host_expect(mine_sweeper_board_pool_pop(popped, board_width, board_height, difficulty, &num_mines, &seed), "pop %d", k);
+        host_expect(seed == (uint64_t)k * 1000 + 7, "pop %d has seed %lu", k, (unsigned long)seed);
+        host_expect(num_mines == get_board_mine_count(board_width, board_height, difficulty), "pop %d has %u mines", k, num_mines);
+        host_expect(memcmp(popped, pushed[k], board_size) == 0, "pop %d has another board", k);
+    }
+
+    uint16_t num_mines;
+    uint64_t seed;
+
+    host_expect(!mine_sweeper_board_pool_pop(popped, board_width, board_height, difficulty, &num_mines, &seed), "empty pool popped");
+
+    // A file with a header for other settings is not read, and is started over by the next push
+    FILE* stale = fopen(pool_path, "wb");
+    furi_check(stale != NULL);
+    fwrite("stale pool file", 1, 15, stale);
+    fclose(stale);
+
+    host_expect(mine_sweeper_board_pool_count(board_width, board_height, difficulty) == 0, "stale file counted");
+
+    // A canceled push writes nothing, not even the header of a stale file
+    const volatile bool is_canceled = true;
+    struct stat pool_stat;
+
+    host_expect(!mine_sweeper_board_pool_push(board, board_width, board_height, difficulty, 1, &is_canceled), "canceled push");
+    host_expect(stat(pool_path, &pool_stat) == 0 && pool_stat.st_size == 15, "canceled push wrote to the card");
+
+    host_expect(mine_sweeper_board_pool_push(board, board_width, board_height, difficulty, 1, NULL), "push over a stale file");
+    host_expect(mine_sweeper_board_pool_count(board_width, board_height, difficulty) == 1, "stale file not started over");
+
+    unlink(pool_path);
+    free_board_scratch();
+
+    printf("test_board_pool: %d failures\n", host_failures);
+
+    return host_failures != 0;
+}
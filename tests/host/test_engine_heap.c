@@ -0,0 +1,91 @@
+// The engine's per-call paths against the heap: once the board memory and the scratch are sized,
+// generating, verifying, scoring and playing a board must not allocate or free anything.
+// Built with the linker wrapping malloc and free, see run.sh, so every heap call of the engine is counted
+
+#include "host.h"
+
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* pointer, size_t size);
+void __real_free(void* pointer);
+
+static bool is_counting = false;
+static uint32_t heap_calls = 0;
+
+void* __wrap_malloc(size_t size) {
+    heap_calls += is_counting;
+    return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+    heap_calls += is_counting;
+    return __real_calloc(count, size);
+}
+
+void* __wrap_realloc(void* pointer, size_t size) {
+    heap_calls += is_counting;
+    return __real_realloc(pointer, size);
+}
+
+void __wrap_free(void* pointer) {
+    heap_calls += is_counting;
+    __real_free(pointer);
+}
+
+static MineSweeperTile board[HOST_BOARD_STORAGE];
+static uint8_t mine_bits[MINESWEEPER_BOARD_MINE_BITS_SIZE(MINESWEEPER_BOARD_MAX_WIDTH, MINESWEEPER_BOARD_MAX_HEIGHT)];
+static HostBoardState state;
+
+// One game on a board of this size through every engine entry point the generator and the game screen call
+static void play_board(const uint8_t board_width, const uint8_t board_height, const uint8_t difficulty, MineSweeperRng* rng) {
+    const Point first_move = {.x = board_height / 2, .y = board_width / 2};
+    MineSweeperBoardDifficulty score;
+    bool is_mine_cleared;
+    Point closest;
+
+    const uint16_t num_mines = setup_board(board, board_width, board_height, difficulty, &first_move, rng);
+    check_board_with_verifier(board, board_width, board_height, num_mines, &first_move, rng, &score);
+    get_board_3bv(board, board_width, board_height);
+    get_live_board_3bv(board, &state.geometry, &state.visited, &state.queue);
+
+    pack_board_mines(board, board_width, board_height, mine_bits);
+    unpack_board_mines(board, board_width, board_height, mine_bits);
+    reset_uncleared_index(&state.uncleared, board, &state.geometry);
+
+    bfs_tile_clear(board, &state.geometry, &state.visited, &state.queue, &state.uncleared, first_move.x, first_move.y);
+
+    for (uint8_t k = 0; k < 20; k++) {
+        const uint16_t tile = mine_sweeper_rng_range(rng, board_width * board_height);
+
+        chord_tile_clear(board, &state.geometry, &state.visited, &state.queue, &state.uncleared, tile / board_width,
+                         tile % board_width, &is_mine_cleared);
+        find_closest_uncleared_tile(&state.uncleared, tile / board_width, tile % board_width, &closest);
+    }
+}
+
+int main(void) {
+    MineSweeperRng rng;
+    mine_sweeper_rng_seed(&rng, 18);
+
+    for (uint16_t k = 0; k < 120; k++) {
+        const uint8_t board_width = host_board_sizes[k % HOST_BOARD_SIZE_COUNT][0];
+        const uint8_t board_height = host_board_sizes[k % HOST_BOARD_SIZE_COUNT][1];
+
+        // Sizing is where the engine is allowed to allocate, the game screen and generator do it between games
+        host_board_state_resize(&state, board_width, board_height);
+
+        heap_calls = 0;
+        is_counting = true;
+        play_board(board_width, board_height, k % 3, &rng);
+        is_counting = false;
+
+        host_expect(heap_calls == 0, "%ux%u board %u made %lu heap calls", board_width, board_height, k,
+                    (unsigned long)heap_calls);
+    }
+
+    host_board_state_free(&state);
+
+    printf("test_engine_heap: %d failures\n", host_failures);
+
+    return host_failures != 0;
+}
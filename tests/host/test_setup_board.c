@@ -0,0 +1,102 @@
+// setup_board against a brute force recount, and the mine layout round trip through pack_board_mines
+
+#include "host.h"
+
+static MineSweeperTile board[HOST_BOARD_STORAGE];
+static MineSweeperTile unpacked[HOST_BOARD_STORAGE];
+static uint8_t mine_bits[MINESWEEPER_BOARD_MINE_BITS_SIZE(MINESWEEPER_BOARD_MAX_WIDTH, MINESWEEPER_BOARD_MAX_HEIGHT)];
+
+static bool is_mine(const uint8_t board_width, const uint8_t board_height, const int16_t x, const int16_t y) {
+    return x >= 0 && y >= 0 && x < board_height && y < board_width &&
+           board[get_board_index(board_width, x, y)].tile_type == MineSweeperGameScreenTileMine;
+}
+
+static void check_board(const uint8_t board_width, const uint8_t board_height, const uint16_t num_mines, const Point* first_move) {
+    uint16_t mines = 0;
+
+    for (uint8_t x = 0; x < board_height; x++) {
+        for (uint8_t y = 0; y < board_width; y++) {
+            const MineSweeperTile tile = board[get_board_index(board_width, x, y)];
+
+            host_expect(tile.tile_state == MineSweeperGameScreenTileStateUncleared, "%ux%u tile %u,%u", board_width, board_height, x, y);
+
+            if (tile.tile_type == MineSweeperGameScreenTileMine) {
+                mines++;
+
+                if (first_move != NULL) {
+                    host_expect(abs(x - first_move->x) > 1 || abs(y - first_move->y) > 1, "mine %u,%u next to the first move", x, y);
+                }
+
+                continue;
+            }
+
+            uint8_t count = 0;
+
+            for (uint8_t j = 0; j < 8; j++) {
+                count += is_mine(board_width, board_height, x + offsets[j][0], y + offsets[j][1]);
+            }
+
+            host_expect(tile.tile_type == MineSweeperGameScreenTileZero + count, "%ux%u tile %u,%u is %u, %u mines around", board_width, board_height, x, y, tile.tile_type, count);
+        }
+    }
+
+    host_expect(mines == num_mines, "%ux%u has %u mines, setup_board placed %u", board_width, board_height, mines, num_mines);
+
+    if (first_move == NULL) {
+        host_expect(!is_mine(board_width, board_height, 0, 0) && !is_mine(board_width, board_height, 0, 1) &&
+                    !is_mine(board_width, board_height, 1, 0) && !is_mine(board_width, board_height, 0, board_width - 1) &&
+                    !is_mine(board_width, board_height, board_height - 1, 0) &&
+                    !is_mine(board_width, board_height, board_height - 1, board_width - 1),
+                    "%ux%u has a mine in a corner", board_width, board_height);
+    }
+
+    // The ring around the board keeps every neighbor walk in bounds
+    const uint16_t stride = MINESWEEPER_BOARD_STRIDE(board_width);
+
+    for (uint16_t pos_1d = 0; pos_1d < MINESWEEPER_BOARD_STORAGE_SIZE(board_width, board_height); pos_1d++) {
+        const uint16_t x = pos_1d / stride;
+        const uint16_t y = pos_1d % stride;
+
+        if (x == 0 || y == 0 || x == board_height + 1 || y == board_width + 1) {
+            host_expect(board[pos_1d].tile_state == MineSweeperGameScreenTileStateBorder, "%ux%u border %u,%u", board_width, board_height, x, y);
+        }
+    }
+}
+
+int main(void) {
+    MineSweeperRng rng;
+    mine_sweeper_rng_seed(&rng, 1);
+
+    for (uint16_t k = 0; k < 3000; k++) {
+        const uint8_t board_width = host_board_sizes[k % HOST_BOARD_SIZE_COUNT][0];
+        const uint8_t board_height = host_board_sizes[k % HOST_BOARD_SIZE_COUNT][1];
+        const uint8_t difficulty = k % 3;
+
+        // Boards too small to keep a mine free square around the first move only use the corners
+        const Point first_move = {
+            .x = mine_sweeper_rng_range(&rng, board_height),
+            .y = mine_sweeper_rng_range(&rng, board_width),
+        };
+        const bool has_first_move = (k & 1) && board_width >= 4 && board_height >= 4;
+
+        furi_check(reserve_board_scratch(board_width, board_height));
+
+        const uint16_t num_mines =
+                setup_board(board, board_width, board_height, difficulty, has_first_move ? &first_move : NULL, &rng);
+
+        host_expect(num_mines == get_board_mine_count(board_width, board_height, difficulty), "%ux%u placed %u mines", board_width, board_height, num_mines);
+        check_board(board_width, board_height, num_mines, has_first_move ? &first_move : NULL);
+
+        pack_board_mines(board, board_width, board_height, mine_bits);
+
+        host_expect(unpack_board_mines(unpacked, board_width, board_height, mine_bits) == num_mines, "%ux%u unpacked mine count", board_width, board_height);
+        host_expect(memcmp(board, unpacked, sizeof(MineSweeperTile) * MINESWEEPER_BOARD_STORAGE_SIZE(board_width, board_height)) == 0,
+                    "%ux%u unpacked board differs", board_width, board_height);
+    }
+
+    free_board_scratch();
+
+    printf("test_setup_board: %d failures\n", host_failures);
+
+    return host_failures != 0;
+}
@@ -0,0 +1,231 @@
+// Clicks, chords and flags through the engine against a plain flood fill, with the uncleared index
+// checked after every move against one built from scratch and against brute force answers
+
+#include "host.h"
+
+static MineSweeperTile board[HOST_BOARD_STORAGE];
+static MineSweeperTile reference[HOST_BOARD_STORAGE];
+static uint16_t reference_stack[MINESWEEPER_BOARD_MAX_TILES];
+static HostBoardState state;
+static MineSweeperUnclearedIndex fresh;
+
+// Clears x,y on the reference board and floods out through zeros, one tile at a time
+static uint16_t reference_clear(const uint8_t board_width, const uint8_t board_height, const uint8_t x, const uint8_t y) {
+    MineSweeperTile* start = &reference[get_board_index(board_width, x, y)];
+
+    if (start->tile_state != MineSweeperGameScreenTileStateUncleared) {
+        return 0;
+    }
+
+    start->tile_state = MineSweeperGameScreenTileStateCleared;
+
+    uint16_t cleared = 1;
+    uint16_t size = 0;
+
+    if (start->tile_type == MineSweeperGameScreenTileZero) {
+        reference_stack[size++] = x * board_width + y;
+    }
+
+    while (size > 0) {
+        const uint16_t tile = reference_stack[--size];
+
+        for (uint8_t j = 0; j < 8; j++) {
+            const int16_t dx = tile / board_width + offsets[j][0];
+            const int16_t dy = tile % board_width + offsets[j][1];
+
+            if (dx < 0 || dy < 0 || dx >= board_height || dy >= board_width) {
+                continue;
+            }
+
+            MineSweeperTile* neighbor = &reference[get_board_index(board_width, dx, dy)];
+
+            if (neighbor->tile_state != MineSweeperGameScreenTileStateUncleared) {
+                continue;
+            }
+
+            neighbor->tile_state = MineSweeperGameScreenTileStateCleared;
+            cleared++;
+
+            if (neighbor->tile_type == MineSweeperGameScreenTileZero) {
+                reference_stack[size++] = dx * board_width + dy;
+            }
+        }
+    }
+
+    return cleared;
+}
+
+static bool is_hidden(const uint8_t board_width, const uint8_t board_height, const int16_t x, const int16_t y) {
+    if (x < 0 || y < 0 || x >= board_height || y >= board_width) {
+        return false;
+    }
+
+    const MineSweeperGameScreenTileState tile_state = board[get_board_index(board_width, x, y)].tile_state;
+
+    return tile_state == MineSweeperGameScreenTileStateUncleared || tile_state == MineSweeperGameScreenTileStateFlagged;
+}
+
+static void check_uncleared_index(const uint8_t board_width, const uint8_t board_height, MineSweeperRng* rng) {
+    const MineSweeperUnclearedIndex* live = &state.uncleared;
+
+    furi_check(resize_uncleared_index(&fresh, board_width, board_height));
+    reset_uncleared_index(&fresh, board, &state.geometry);
+
+    host_expect(live->count == fresh.count, "%ux%u %u uncleared, %u from scratch", board_width, board_height, live->count, fresh.count);
+    host_expect(memcmp(live->rows, fresh.rows, sizeof(uint32_t) * live->row_words * board_height) == 0, "%ux%u rows", board_width, board_height);
+    host_expect(memcmp(live->row_counts, fresh.row_counts, board_height) == 0, "%ux%u row counts", board_width, board_height);
+
+    // Cleared numbers touching an uncleared or flagged tile
+    uint16_t frontier_count = 0;
+
+    for (uint8_t x = 0; x < board_height; x++) {
+        for (uint8_t y = 0; y < board_width; y++) {
+            const uint16_t pos_1d = get_board_index(board_width, x, y);
+            const MineSweeperTile tile = board[pos_1d];
+            bool is_frontier = false;
+
+            if (tile.tile_state == MineSweeperGameScreenTileStateCleared && tile.tile_type >= MineSweeperGameScreenTileOne &&
+                tile.tile_type <= MineSweeperGameScreenTileEight) {
+                for (uint8_t j = 0; j < 8; j++) {
+                    is_frontier |= is_hidden(board_width, board_height, x + offsets[j][0], y + offsets[j][1]);
+                }
+            }
+
+            frontier_count += is_frontier;
+            host_expect(is_frontier_tile(live, pos_1d) == is_frontier, "%ux%u frontier tile %u,%u", board_width, board_height, x, y);
+        }
+    }
+
+    uint16_t walked = 0;
+
+    for (uint16_t pos_1d = get_next_frontier_tile(live, 0); pos_1d != 0; pos_1d = get_next_frontier_tile(live, pos_1d + 1)) {
+        walked++;
+    }
+
+    host_expect(live->frontier_count == frontier_count && walked == frontier_count && fresh.frontier_count == frontier_count,
+                "%ux%u frontier of %u, counted %u, walked %u, from scratch %u", board_width, board_height, frontier_count,
+                live->frontier_count, walked, fresh.frontier_count);
+
+    // Any tile at the closest distance is a right answer, so only the distance is compared
+    const uint8_t from_x = mine_sweeper_rng_range(rng, board_height);
+    const uint8_t from_y = mine_sweeper_rng_range(rng, board_width);
+    int32_t closest = -1;
+
+    for (uint8_t x = 0; x < board_height; x++) {
+        for (uint8_t y = 0; y < board_width; y++) {
+            if (board[get_board_index(board_width, x, y)].tile_state == MineSweeperGameScreenTileStateUncleared) {
+                const int32_t distance = (x - from_x) * (x - from_x) + (y - from_y) * (y - from_y);
+
+                if (closest < 0 || distance < closest) {
+                    closest = distance;
+                }
+            }
+        }
+    }
+
+    Point found;
+
+    if (find_closest_uncleared_tile(live, from_x, from_y, &found)) {
+        const int32_t distance = (found.x - from_x) * (found.x - from_x) + (found.y - from_y) * (found.y - from_y);
+
+        host_expect(distance == closest, "%ux%u closest to %u,%u at %ld, found %u,%u", board_width, board_height, from_x, from_y,
+                    (long)closest, found.x, found.y);
+        host_expect(board[get_board_index(board_width, found.x, found.y)].tile_state == MineSweeperGameScreenTileStateUncleared,
+                    "%ux%u found %u,%u", board_width, board_height, found.x, found.y);
+    } else {
+        host_expect(closest < 0, "%ux%u found nothing", board_width, board_height);
+    }
+}
+
+int main(void) {
+    MineSweeperRng rng;
+    mine_sweeper_rng_seed(&rng, 5);
+
+    uint32_t moves = 0, mines_chorded = 0;
+
+    for (uint16_t k = 0; k < 1000; k++) {
+        const uint8_t board_width = host_board_sizes[k % HOST_BOARD_SIZE_COUNT][0];
+        const uint8_t board_height = host_board_sizes[k % HOST_BOARD_SIZE_COUNT][1];
+        const uint16_t storage_size = MINESWEEPER_BOARD_STORAGE_SIZE(board_width, board_height);
+
+        host_board_state_resize(&state, board_width, board_height);
+        setup_board(board, board_width, board_height, k % 3, NULL, &rng);
+
+        host_scatter_states(board, board_width, board_height, k % 4, &rng);
+        reset_uncleared_index(&state.uncleared, board, &state.geometry);
+        memcpy(reference, board, sizeof(MineSweeperTile) * storage_size);
+
+        for (uint8_t n = 0; n < 100; n++) {
+            const uint16_t tile = mine_sweeper_rng_range(&rng, board_width * board_height);
+            const uint8_t x = tile / board_width;
+            const uint8_t y = tile % board_width;
+            const uint16_t pos_1d = get_board_index(board_width, x, y);
+            const uint8_t move = mine_sweeper_rng_range(&rng, 4);
+
+            uint16_t cleared = 0, reference_cleared = 0;
+
+            if (move == 0 && board[pos_1d].tile_type != MineSweeperGameScreenTileMine) {
+                cleared = bfs_tile_clear(board, &state.geometry, &state.visited, &state.queue, &state.uncleared, x, y);
+
+                reference_cleared = reference_clear(board_width, board_height, x, y);
+
+            } else if (move == 1) {
+                bool is_mine_cleared = false;
+                bool is_reference_mine_cleared = false;
+
+                cleared = chord_tile_clear(
+                        board, &state.geometry, &state.visited, &state.queue, &state.uncleared, x, y, &is_mine_cleared);
+
+                for (uint8_t j = 0; j < 8; j++) {
+                    const int16_t dx = x + offsets[j][0];
+                    const int16_t dy = y + offsets[j][1];
+
+                    if (dx < 0 || dy < 0 || dx >= board_height || dy >= board_width) {
+                        continue;
+                    }
+
+                    const MineSweeperTile neighbor = reference[get_board_index(board_width, dx, dy)];
+
+                    is_reference_mine_cleared |= neighbor.tile_state == MineSweeperGameScreenTileStateUncleared &&
+                                                 neighbor.tile_type == MineSweeperGameScreenTileMine;
+                    reference_cleared += reference_clear(board_width, board_height, dx, dy);
+                }
+
+                host_expect(is_mine_cleared == is_reference_mine_cleared, "%ux%u chord at %u,%u", board_width, board_height, x, y);
+                mines_chorded += is_mine_cleared;
+
+            } else if (move == 2 && board[pos_1d].tile_state != MineSweeperGameScreenTileStateCleared) {
+                // A flag toggle, the way handle_long_back_flag_input does it
+                const MineSweeperGameScreenTileState tile_state =
+                        (board[pos_1d].tile_state == MineSweeperGameScreenTileStateFlagged) ?
+                                MineSweeperGameScreenTileStateUncleared :
+                                MineSweeperGameScreenTileStateFlagged;
+
+                board[pos_1d].tile_state = tile_state;
+                reference[pos_1d].tile_state = tile_state;
+                update_uncleared_index(&state.uncleared, board, pos_1d);
+            }
+
+            moves++;
+
+            host_expect(cleared == reference_cleared, "%ux%u move %u at %u,%u cleared %u, reference %u", board_width, board_height,
+                        move, x, y, cleared, reference_cleared);
+            host_expect(memcmp(board, reference, sizeof(MineSweeperTile) * storage_size) == 0, "%ux%u move %u at %u,%u",
+                        board_width, board_height, move, x, y);
+
+            check_uncleared_index(board_width, board_height, &rng);
+
+            if (host_failures > 0) {
+                break;
+            }
+        }
+    }
+
+    free_uncleared_index(&fresh);
+    host_board_state_free(&state);
+
+    printf("test_tile_clear: %d failures over %lu moves, %lu chords hit a mine\n", host_failures, (unsigned long)moves,
+           (unsigned long)mines_chorded);
+
+    return host_failures != 0;
+}
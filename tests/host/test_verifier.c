@@ -0,0 +1,64 @@
+// check_board_with_verifier leaves the tile states alone, keeps the mine count through repairs,
+// and a board it passed after repairs passes again without them
+
+#include "host.h"
+
+static MineSweeperTile board[HOST_BOARD_STORAGE];
+
+static uint16_t count_mines(const uint8_t board_width, const uint8_t board_height) {
+    uint16_t mines = 0;
+
+    for (uint8_t x = 0; x < board_height; x++) {
+        for (uint8_t y = 0; y < board_width; y++) {
+            mines += board[get_board_index(board_width, x, y)].tile_type == MineSweeperGameScreenTileMine;
+        }
+    }
+
+    return mines;
+}
+
+int main(void) {
+    static const uint8_t sizes[][2] = {{16, 7}, {32, 32}, {20, 20}, {146, 7}, {40, 30}, {16, 12}, {24, 8}};
+
+    MineSweeperRng rng;
+    mine_sweeper_rng_seed(&rng, 7);
+
+    uint16_t solved = 0;
+
+    for (uint16_t k = 0; k < 1000; k++) {
+        const uint8_t board_width = sizes[k % COUNT_OF(sizes)][0];
+        const uint8_t board_height = sizes[k % COUNT_OF(sizes)][1];
+        const Point first_move = {
+            .x = mine_sweeper_rng_range(&rng, board_height),
+            .y = mine_sweeper_rng_range(&rng, board_width),
+        };
+        const Point* start = (k & 1) ? &first_move : NULL;
+
+        furi_check(reserve_board_scratch(board_width, board_height));
+
+        const uint16_t num_mines = setup_board(board, board_width, board_height, k % 3, start, &rng);
+        MineSweeperBoardDifficulty difficulty;
+
+        const bool is_solvable = check_board_with_verifier(board, board_width, board_height, num_mines, start, &rng, &difficulty);
+
+        host_expect(host_count_state(board, board_width, board_height, MineSweeperGameScreenTileStateUncleared) ==
+                            board_width * board_height,
+                    "%ux%u board %u has tiles that are not uncleared", board_width, board_height, k);
+        host_expect(count_mines(board_width, board_height) == num_mines, "%ux%u board %u lost mines in repairs", board_width, board_height, k);
+
+        if (!is_solvable) {
+            continue;
+        }
+
+        solved++;
+
+        host_expect(check_board_with_verifier(board, board_width, board_height, num_mines, start, NULL, NULL),
+                    "%ux%u board %u does not verify again", board_width, board_height, k);
+    }
+
+    free_board_scratch();
+
+    printf("test_verifier: %d failures, %u of 1000 boards solved\n", host_failures, solved);
+
+    return host_failures != 0;
+}
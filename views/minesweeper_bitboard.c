@@ -0,0 +1,366 @@
+#include "minesweeper_bitboard.h"
+
+#ifdef MINESWEEPER_ENGINE_BITBOARD
+
+// Floods keep the rows they still have to open from in the bits of one word
+_Static_assert(MINESWEEPER_BOARD_MAX_HEIGHT <= 64, "bit plane floods need a board of at most 64 rows");
+
+static const uint32_t empty_row[MINESWEEPER_BITBOARD_MAX_ROW_WORDS] = {0};
+
+// Word k of a row moved one tile to the east, so bit y holds the tile at y-1
+static inline uint32_t shift_row_east(const uint32_t* row, const uint8_t k) {
+    return (row[k] << 1) | ((k > 0) ? row[k - 1] >> 31 : 0);
+}
+
+// Word k of a row moved one tile to the west, so bit y holds the tile at y+1
+static inline uint32_t shift_row_west(const uint32_t* row, const uint8_t k, const uint8_t row_words) {
+    return (row[k] >> 1) | ((k + 1 < row_words) ? row[k + 1] << 31 : 0);
+}
+
+// Word k of a row together with both of its horizontal neighbors
+static inline uint32_t spread_row(const uint32_t* row, const uint8_t k, const uint8_t row_words) {
+    return row[k] | shift_row_east(row, k) | shift_row_west(row, k, row_words);
+}
+
+void reset_bitboard_planes(MineSweeperUnclearedIndex* uncleared, const MineSweeperTile* board) {
+    furi_assert(uncleared);
+    furi_assert(board);
+
+    const uint8_t board_width = uncleared->board_width;
+    const uint8_t row_words = uncleared->row_words;
+
+    uncleared->mine_count = 0;
+
+    for (uint8_t x = 0; x < uncleared->board_height; x++) {
+        const MineSweeperTile* row = &board[get_board_index(board_width, x, 0)];
+
+        for (uint8_t y = 0; y < board_width; y++) {
+            if (row[y].tile_type == MineSweeperGameScreenTileMine) {
+                set_plane_tile(uncleared->mines, row_words, x, y, true);
+                uncleared->mine_count++;
+            } else if (row[y].tile_type == MineSweeperGameScreenTileZero) {
+                set_plane_tile(uncleared->zeros, row_words, x, y, true);
+            }
+
+            if (row[y].tile_state == MineSweeperGameScreenTileStateFlagged) {
+                set_plane_tile(uncleared->flags, row_words, x, y, true);
+            }
+        }
+    }
+}
+
+/**
+ * The eight shifted neighbor rows are added up with a bit sliced counter, so every word
+ * holds the mine counts of 32 tiles in four bit planes and no tile is looked at on its own
+ * until its type is written.
+ */
+void number_board_from_mines(
+        const uint32_t* mines,
+        MineSweeperTile* board,
+        const uint8_t board_width,
+        const uint8_t board_height) {
+
+    furi_assert(mines);
+    furi_assert(board);
+    furi_assert(board_width <= MINESWEEPER_BOARD_MAX_WIDTH && board_height <= MINESWEEPER_BOARD_MAX_HEIGHT);
+
+    const uint8_t row_words = (board_width + 31) / 32;
+
+    for (uint8_t x = 0; x < board_height; x++) {
+        const uint32_t* above = (x > 0) ? &mines[(x - 1) * row_words] : empty_row;
+        const uint32_t* row = &mines[x * row_words];
+        const uint32_t* below = (x + 1 < board_height) ? &mines[(x + 1) * row_words] : empty_row;
+        MineSweeperTile* tiles = &board[get_board_index(board_width, x, 0)];
+
+        for (uint8_t k = 0; k < row_words; k++) {
+            const uint32_t neighbors[8] = {
+                shift_row_east(above, k),
+                above[k],
+                shift_row_west(above, k, row_words),
+                shift_row_east(row, k),
+                shift_row_west(row, k, row_words),
+                shift_row_east(below, k),
+                below[k],
+                shift_row_west(below, k, row_words),
+            };
+
+            // Ripple carry add of one bit per tile into a four bit count per tile
+            uint32_t sum[4] = {0, 0, 0, 0};
+
+            for (uint8_t j = 0; j < 8; j++) {
+                uint32_t carry = neighbors[j];
+
+                for (uint8_t b = 0; b < 4 && carry != 0; b++) {
+                    const uint32_t next_carry = sum[b] & carry;
+                    sum[b] ^= carry;
+                    carry = next_carry;
+                }
+            }
+
+            const uint8_t first_y = k * 32;
+            const uint8_t last_y = (board_width - first_y > 32) ? first_y + 32 : board_width;
+
+            for (uint8_t y = first_y; y < last_y; y++) {
+                const uint8_t bit = y & 31;
+
+                if ((row[k] >> bit) & 1) {
+                    tiles[y].tile_type = MineSweeperGameScreenTileMine;
+                } else {
+                    const uint8_t mine_count = ((sum[0] >> bit) & 1)        |
+                                               (((sum[1] >> bit) & 1) << 1) |
+                                               (((sum[2] >> bit) & 1) << 2) |
+                                               (((sum[3] >> bit) & 1) << 3);
+
+                    tiles[y].tile_type = (MineSweeperGameScreenTileType) mine_count+1;
+                }
+
+                tiles[y].tile_state = MineSweeperGameScreenTileStateUncleared;
+            }
+        }
+    }
+}
+
+/**
+ * Fills the runs of mask that hold a tile of seeds, over every word of a row. Each direction
+ * is a doubling fill inside a word that is carried on into the next one, so a run of any length
+ * takes five steps per word and direction instead of one step per tile.
+ */
+static void fill_row_runs(const uint32_t* seeds, const uint32_t* mask, uint32_t* runs, const uint8_t row_words) {
+    uint32_t carry = 0;
+
+    for (uint8_t k = 0; k < row_words; k++) {
+        uint32_t fill = seeds[k] | (carry & mask[k]);
+        uint32_t open = mask[k];
+
+        fill |= open & (fill << 1);
+        open &= open << 1;
+        fill |= open & (fill << 2);
+        open &= open << 2;
+        fill |= open & (fill << 4);
+        open &= open << 4;
+        fill |= open & (fill << 8);
+        open &= open << 8;
+        fill |= open & (fill << 16);
+
+        runs[k] = fill;
+        carry = fill >> 31;
+    }
+
+    carry = 0;
+
+    for (uint8_t k = row_words; k-- > 0;) {
+        uint32_t fill = seeds[k] | (carry & mask[k]);
+        uint32_t open = mask[k];
+
+        fill |= open & (fill >> 1);
+        open &= open >> 1;
+        fill |= open & (fill >> 2);
+        open &= open >> 2;
+        fill |= open & (fill >> 4);
+        open &= open >> 4;
+        fill |= open & (fill >> 8);
+        open &= open >> 8;
+        fill |= open & (fill >> 16);
+
+        runs[k] |= fill;
+        carry = fill << 31;
+    }
+}
+
+/**
+ * Clears the tiles of one word of row x on the board and in the index, returns how many there were
+ */
+static uint16_t clear_plane_tiles(
+        MineSweeperTile* board,
+        MineSweeperUnclearedIndex* uncleared,
+        const uint8_t x,
+        const uint8_t k,
+        uint32_t bits) {
+
+    const uint16_t word_pos_1d = get_board_index(uncleared->board_width, x, k * 32);
+    const uint16_t count = __builtin_popcount(bits);
+
+    while (bits != 0) {
+        const uint16_t pos_1d = word_pos_1d + __builtin_ctz(bits);
+        bits &= bits - 1;
+
+        board[pos_1d].tile_state = MineSweeperGameScreenTileStateCleared;
+        update_uncleared_index(uncleared, board, pos_1d);
+    }
+
+    return count;
+}
+
+/**
+ * Opens the neighbors of the pending zeros of the rows in dirty_rows until no zero is left pending.
+ * A row fills the runs of uncleared zeros its pending zeros are in first, and those runs together with
+ * their neighbors on both sides are dilated into the row and the rows above and below, masked by the
+ * uncleared rows. Zeros that open in the rows above and below become pending there.
+ * Cleared and flagged tiles are not in the uncleared rows, so they stop the flood where bfs_tile_clear stops.
+ */
+static uint16_t flood_bitboard(MineSweeperTile* board, MineSweeperUnclearedIndex* uncleared, uint64_t dirty_rows) {
+    const uint8_t row_words = uncleared->row_words;
+    const uint8_t board_height = uncleared->board_height;
+
+    uint32_t mask[MINESWEEPER_BITBOARD_MAX_ROW_WORDS];
+    uint32_t runs[MINESWEEPER_BITBOARD_MAX_ROW_WORDS];
+    uint32_t reach[MINESWEEPER_BITBOARD_MAX_ROW_WORDS];
+    uint16_t ret = 0;
+
+    while (dirty_rows != 0) {
+        const uint8_t x = __builtin_ctzll(dirty_rows);
+        dirty_rows &= dirty_rows - 1;
+
+        uint32_t* pending = &uncleared->pending[x * row_words];
+        const uint32_t* zeros = &uncleared->zeros[x * row_words];
+        const uint32_t* open = &uncleared->rows[x * row_words];
+
+        // Pending zeros are cleared already, their runs go on through the zeros that are still uncleared
+        for (uint8_t k = 0; k < row_words; k++) {
+            mask[k] = (zeros[k] & open[k]) | pending[k];
+        }
+
+        fill_row_runs(pending, mask, runs, row_words);
+        memset(pending, 0, sizeof(uint32_t) * row_words);
+
+        for (uint8_t k = 0; k < row_words; k++) {
+            reach[k] = spread_row(runs, k, row_words);
+        }
+
+        for (int8_t dx = -1; dx <= 1; dx++) {
+            const int16_t row = x + dx;
+
+            if (row < 0 || row >= board_height) {
+                continue;
+            }
+
+            const uint32_t* row_open = &uncleared->rows[row * row_words];
+            const uint32_t* row_zeros = &uncleared->zeros[row * row_words];
+
+            for (uint8_t k = 0; k < row_words; k++) {
+                const uint32_t opened = reach[k] & row_open[k];
+
+                if (opened == 0) {
+                    continue;
+                }
+
+                const uint32_t opened_zeros = opened & row_zeros[k];
+
+                ret += clear_plane_tiles(board, uncleared, row, k, opened);
+
+                // The zeros opened in row x itself are all in its runs, which are spread already
+                if (dx != 0 && opened_zeros != 0) {
+                    uncleared->pending[row * row_words + k] |= opened_zeros;
+                    dirty_rows |= (uint64_t)1 << row;
+                }
+            }
+        }
+    }
+
+    return ret;
+}
+
+uint16_t bitboard_tile_clear(
+        MineSweeperTile* board,
+        const MineSweeperBoardGeometry* geometry,
+        MineSweeperUnclearedIndex* uncleared,
+        const uint16_t x,
+        const uint16_t y) {
+
+    furi_assert(board);
+    furi_assert(geometry);
+    furi_assert(uncleared);
+    furi_assert(uncleared->pending);
+    furi_assert(x < geometry->height && y < geometry->width);
+
+    const uint16_t start_pos_1d = get_board_index(geometry->width, x, y);
+
+    // Cleared and flagged tiles are left alone, a number is the only tile it clears
+    if (board[start_pos_1d].tile_state != MineSweeperGameScreenTileStateUncleared) {
+        return 0;
+    }
+
+    board[start_pos_1d].tile_state = MineSweeperGameScreenTileStateCleared;
+    update_uncleared_index(uncleared, board, start_pos_1d);
+
+    uint16_t ret = 1;
+
+    if (board[start_pos_1d].tile_type == MineSweeperGameScreenTileZero) {
+        set_plane_tile(uncleared->pending, uncleared->row_words, x, y, true);
+        ret += flood_bitboard(board, uncleared, (uint64_t)1 << x);
+    }
+
+    refresh_frontier(uncleared, board, geometry);
+
+    return ret;
+}
+
+uint16_t bitboard_chord_clear(
+        MineSweeperTile* board,
+        const MineSweeperBoardGeometry* geometry,
+        MineSweeperUnclearedIndex* uncleared,
+        const uint16_t x,
+        const uint16_t y,
+        bool* is_mine_cleared) {
+
+    furi_assert(board);
+    furi_assert(geometry);
+    furi_assert(uncleared);
+    furi_assert(uncleared->pending);
+    furi_assert(is_mine_cleared);
+    furi_assert(x < geometry->height && y < geometry->width);
+
+    const uint16_t curr_pos_1d = get_board_index(geometry->width, x, y);
+
+    uint16_t ret = 0;
+    uint64_t dirty_rows = 0;
+    *is_mine_cleared = false;
+
+    // Border tiles are never uncleared, so they need no bounds checks
+    for (uint8_t j = 0; j < 8; j++) {
+        const uint16_t pos_1d = curr_pos_1d + geometry->neighbor_offsets[j];
+        MineSweeperTile* tile = &board[pos_1d];
+
+        if (tile->tile_state != MineSweeperGameScreenTileStateUncleared) {
+            continue;
+        }
+
+        if (tile->tile_type == MineSweeperGameScreenTileMine) {
+            *is_mine_cleared = true;
+        }
+
+        tile->tile_state = MineSweeperGameScreenTileStateCleared;
+        update_uncleared_index(uncleared, board, pos_1d);
+        ret++;
+
+        // Zero neighbors seed one flood together
+        if (tile->tile_type == MineSweeperGameScreenTileZero) {
+            set_plane_tile(uncleared->pending, uncleared->row_words, x + offsets[j][0], y + offsets[j][1], true);
+            dirty_rows |= (uint64_t)1 << (x + offsets[j][0]);
+        }
+    }
+
+    ret += flood_bitboard(board, uncleared, dirty_rows);
+
+    refresh_frontier(uncleared, board, geometry);
+
+    return ret;
+}
+
+bool is_bitboard_solved(const MineSweeperUnclearedIndex* uncleared) {
+    furi_assert(uncleared);
+    furi_assert(uncleared->mines);
+
+    const uint16_t num_words = uncleared->row_words * uncleared->board_height;
+    uint16_t flagged_mines = 0;
+    uint16_t hidden = 0;
+
+    for (uint16_t k = 0; k < num_words; k++) {
+        flagged_mines += __builtin_popcount(uncleared->flags[k] & uncleared->mines[k]);
+        hidden += __builtin_popcount(uncleared->flags[k] | uncleared->rows[k]);
+    }
+
+    return flagged_mines == uncleared->mine_count && hidden == uncleared->mine_count;
+}
+
+#endif
@@ -0,0 +1,107 @@
+/**
+ * @file minesweeper_bitboard.h
+ * Bit plane engine
+ *
+ * Keeps the mines, the zeros and the flags of a board as planes of one bit per tile, in rows of
+ * words like the rows of the uncleared index, which holds the planes when MINESWEEPER_ENGINE_BITBOARD
+ * is defined. Numbers are added up from shifted rows of the mine plane, floods open whole rows of
+ * tiles at a time by dilating through the zero plane, and a win is counted from the planes.
+ *
+ * The tile array stays the board the game draws and the verifier solves, every tile a flood opens
+ * is written back to it. bfs_tile_clear and chord_tile_clear keep walking the tile array in both builds,
+ * so the two engines can be compared in one build, see tests/host/bench_bitboard.c.
+ */
+
+#ifndef MINESWEEPER_BITBOARD_H
+#define MINESWEEPER_BITBOARD_H
+
+#include "minesweeper_engine.h"
+
+#ifdef MINESWEEPER_ENGINE_BITBOARD
+
+// Words in the widest row a plane holds
+#define MINESWEEPER_BITBOARD_MAX_ROW_WORDS ((MINESWEEPER_BOARD_MAX_WIDTH + 31) / 32)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+static inline void set_plane_tile(
+        uint32_t* plane,
+        const uint8_t row_words,
+        const uint8_t x,
+        const uint8_t y,
+        const bool is_set) {
+
+    uint32_t* word = &plane[x * row_words + (y >> 5)];
+    const uint32_t bit = (uint32_t)1 << (y & 31);
+
+    *word = is_set ? (*word | bit) : (*word & ~bit);
+}
+
+/** Load the mine, zero and flag planes of an uncleared index from the tiles of a board
+ *
+ * Called by reset_uncleared_index, single tiles are kept up to date by update_uncleared_index.
+ *
+ * @param       uncleared   MineSweeperUnclearedIndex* sized for board, with its planes cleared
+ */
+void reset_bitboard_planes(MineSweeperUnclearedIndex* uncleared, const MineSweeperTile* board);
+
+/** Number every tile of a board from a plane of its mines
+ *
+ * Every tile gets its type and is left uncleared, like setup_board does. The border ring is not written.
+ *
+ * @param       mines       const uint32_t* plane of the mines, (board_width + 31) / 32 words per row
+ * @param       board       MineSweeperTile* buffer of at least MINESWEEPER_BOARD_STORAGE_SIZE tiles
+ */
+void number_board_from_mines(
+        const uint32_t* mines,
+        MineSweeperTile* board,
+        const uint8_t board_width,
+        const uint8_t board_height);
+
+/** Clear the tile at x,y and flood out through zero tiles on the planes, same as bfs_tile_clear
+ *
+ * @param       geometry    const MineSweeperBoardGeometry* set up for the size of board
+ * @param       uncleared   MineSweeperUnclearedIndex* of board, updated with every cleared tile
+ * @return      uint16_t number of tiles cleared
+ */
+uint16_t bitboard_tile_clear(
+        MineSweeperTile* board,
+        const MineSweeperBoardGeometry* geometry,
+        MineSweeperUnclearedIndex* uncleared,
+        const uint16_t x,
+        const uint16_t y);
+
+/** Clear every uncleared neighbor of the tile at x,y in one flood on the planes, same as chord_tile_clear
+ *
+ * @param       geometry        const MineSweeperBoardGeometry* set up for the size of board
+ * @param       uncleared       MineSweeperUnclearedIndex* of board, updated with every cleared tile
+ * @param       is_mine_cleared bool* set to true if one of the cleared tiles is a mine
+ * @return      uint16_t number of tiles cleared
+ */
+uint16_t bitboard_chord_clear(
+        MineSweeperTile* board,
+        const MineSweeperBoardGeometry* geometry,
+        MineSweeperUnclearedIndex* uncleared,
+        const uint16_t x,
+        const uint16_t y,
+        bool* is_mine_cleared);
+
+/** Check whether a game is won from the planes
+ *
+ * A game is won when every mine is flagged and the flagged and uncleared tiles together are the mines,
+ * both counted with popcounts. Only meant for games that have not hit a mine.
+ *
+ * @param       uncleared   const MineSweeperUnclearedIndex* of the board
+ * @return      bool true if the game is won
+ */
+bool is_bitboard_solved(const MineSweeperUnclearedIndex* uncleared);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+#endif
@@ -0,0 +1,502 @@
+#include "minesweeper_board_generator.h"
+#include "../helpers/mine_sweeper_board_pool.h"
+
+#define MINESWEEPER_GENERATOR_TAG "Mine Sweeper Generator"
+
+// How often the progress callback is called while a job is running
+#define MINESWEEPER_GENERATOR_REPORT_INTERVAL_MS 250
+
+struct MineSweeperBoardGenerator {
+    FuriThread* thread;
+    FuriMutex* mutex;           // Guards progress
+    FuriMutex* callback_mutex;  // Held while the callback runs so it can be removed safely
+    MineSweeperTile* board;     // Board being built, private until swapped out
+    uint16_t board_size;        // Tiles in board, resized to the board of each job
+    MineSweeperBoardConfig config;
+    uint64_t seed;
+    uint16_t num_mines;
+    MineSweeperBoardGeneratorProgress progress;
+    MineSweeperBoardGeneratorCallback callback;
+    void* callback_context;
+    volatile bool is_canceled;
+    bool is_refill_job;         // Job fills the SD card pool instead of building a board to take
+};
+
+static void mine_sweeper_board_generator_report(
+        MineSweeperBoardGenerator* instance,
+        MineSweeperBoardGeneratorState state,
+        uint32_t attempts,
+        uint32_t elapsed_ticks) {
+
+    furi_mutex_acquire(instance->mutex, FuriWaitForever);
+    instance->progress.state = state;
+    instance->progress.attempts = attempts;
+    instance->progress.elapsed_ticks = elapsed_ticks;
+    MineSweeperBoardGeneratorProgress progress = instance->progress;
+    furi_mutex_release(instance->mutex);
+
+    furi_mutex_acquire(instance->callback_mutex, FuriWaitForever);
+    if (instance->callback != NULL) {
+        instance->callback(&progress, instance->callback_context);
+    }
+    furi_mutex_release(instance->callback_mutex);
+}
+
+static bool mine_sweeper_board_generator_is_in_3bv_band(
+        const MineSweeperTile* board,
+        const MineSweeperBoardConfig* config) {
+
+    if (!mine_sweeper_board_config_has_3bv_band(config)) {
+        return true;
+    }
+
+    const uint16_t board_3bv = get_board_3bv(board, config->width, config->height);
+
+    return (config->min_3bv == 0 || board_3bv >= config->min_3bv) &&
+           (config->max_3bv == 0 || board_3bv <= config->max_3bv);
+}
+
+static bool mine_sweeper_board_generator_is_in_difficulty_band(
+        MineSweeperTile* board,
+        const MineSweeperBoardConfig* config,
+        uint16_t num_mines,
+        MineSweeperBoardDifficulty* difficulty) {
+
+    const MineSweeperBoardDifficulty* min = &config->min_difficulty;
+    const MineSweeperBoardDifficulty* max = &config->max_difficulty;
+    const Point* first_move = config->has_first_move ? &config->first_move : NULL;
+
+    // After repairs the score describes the path to a board that no longer exists, so the final board is scored again.
+    // This second run only happens for boards that already passed the verifier
+    if (difficulty->repairs > 0) {
+        if (!check_board_with_verifier(board, config->width, config->height, num_mines, first_move, NULL, difficulty)) {
+            return false;
+        }
+    }
+
+    return (min->passes == 0 || difficulty->passes >= min->passes) &&
+           (max->passes == 0 || difficulty->passes <= max->passes) &&
+           (min->largest_frontier == 0 || difficulty->largest_frontier >= min->largest_frontier) &&
+           (max->largest_frontier == 0 || difficulty->largest_frontier <= max->largest_frontier) &&
+           (min->deepest_rule == 0 || difficulty->deepest_rule >= min->deepest_rule) &&
+           (max->deepest_rule == 0 || difficulty->deepest_rule <= max->deepest_rule);
+}
+
+/**
+ * Runs generation attempts into the private board until one is valid, the job is canceled or the budget runs out.
+ * Every attempt draws from a generator seeded with seed, so the whole rejection loop,
+ * and with it the final board, only depends on the seed.
+ * Progress is reported from report_tick with the attempts made before this run added on.
+ */
+static MineSweeperBoardGeneratorState mine_sweeper_board_generator_build(
+        MineSweeperBoardGenerator* instance,
+        const MineSweeperBoardConfig* job_config,
+        uint64_t seed,
+        const MineSweeperBoardBudget* budget,
+        bool is_reporting,
+        uint32_t report_tick,
+        uint32_t* attempts) {
+
+    const MineSweeperBoardConfig config = *job_config;
+    const uint32_t budget_ticks = furi_ms_to_ticks(budget->max_ms);
+    const uint32_t report_ticks = furi_ms_to_ticks(MINESWEEPER_GENERATOR_REPORT_INTERVAL_MS);
+    const Point* first_move = config.has_first_move ? &config.first_move : NULL;
+    const bool is_banded = mine_sweeper_board_config_has_3bv_band(&config);
+    const bool is_graded = mine_sweeper_board_config_has_difficulty_band(&config);
+    const bool is_verified = config.ensure_solvable || is_graded;
+
+    MineSweeperRng rng;
+    mine_sweeper_rng_seed(&rng, seed);
+
+    const uint32_t start_tick = furi_get_tick();
+    uint32_t last_report_tick = start_tick;
+    uint32_t job_attempts = 0;
+    uint16_t num_mines = 0;
+    bool is_valid_board = false;
+    bool is_over_budget = false;
+
+    do {
+        num_mines = setup_board(instance->board, config.width, config.height, config.difficulty, first_move, &rng);
+        job_attempts++;
+
+        if (!is_verified && !is_banded) {
+            is_valid_board = true;
+            break;
+        }
+
+        // Counting the 3BV is a single pass over the board, so it rejects layouts before the verifier has to run
+        is_valid_board = mine_sweeper_board_generator_is_in_3bv_band(instance->board, &config);
+
+        if (is_valid_board && is_verified) {
+            MineSweeperBoardDifficulty difficulty;
+
+            // The verifier repairs the layout in place, so it runs on the board itself
+            is_valid_board = check_board_with_verifier(
+                    instance->board, config.width, config.height, num_mines, first_move, &rng, &difficulty);
+
+            // Repairs move mines around, which can take the 3BV out of the band again
+            if (is_valid_board && is_banded) {
+                is_valid_board = mine_sweeper_board_generator_is_in_3bv_band(instance->board, &config);
+            }
+
+            if (is_valid_board && is_graded) {
+                is_valid_board = mine_sweeper_board_generator_is_in_difficulty_band(
+                        instance->board, &config, num_mines, &difficulty);
+            }
+        }
+
+        const uint32_t now = furi_get_tick();
+        const uint32_t elapsed_ticks = now - start_tick;
+
+        is_over_budget = (budget->max_attempts != 0 && job_attempts >= budget->max_attempts) ||
+                         (budget->max_ms != 0 && elapsed_ticks >= budget_ticks);
+
+        if (is_reporting && now - last_report_tick >= report_ticks) {
+            last_report_tick = now;
+            mine_sweeper_board_generator_report(
+                    instance, MineSweeperBoardGeneratorStateRunning, *attempts + job_attempts, now - report_tick);
+        }
+
+    } while (!is_valid_board && !instance->is_canceled && !is_over_budget);
+
+    instance->num_mines = num_mines;
+    *attempts += job_attempts;
+
+    if (!is_valid_board) {
+        return instance->is_canceled ? MineSweeperBoardGeneratorStateCanceled : MineSweeperBoardGeneratorStateFailed;
+    }
+
+    return MineSweeperBoardGeneratorStateDone;
+}
+
+/**
+ * Adds boards to the SD card pool until it is full or the job is canceled.
+ * Each board gets its own seed so it can be reproduced like any other board.
+ * The cancel flag is checked between attempts and right before every write to the card,
+ * so a cancel only ever waits for an attempt or a write that is already under way.
+ */
+static void mine_sweeper_board_generator_refill(MineSweeperBoardGenerator* instance) {
+    const MineSweeperBoardConfig config = instance->config;
+    const MineSweeperBoardBudget budget = {0};
+
+    MineSweeperRng rng;
+    mine_sweeper_rng_seed(&rng, instance->seed);
+
+    uint16_t count = mine_sweeper_board_pool_count(config.width, config.height, config.difficulty);
+    uint32_t attempts = 0;
+
+    while (!instance->is_canceled && count < MINESWEEPER_BOARD_POOL_CAPACITY) {
+        uint64_t board_seed = mine_sweeper_rng_next64(&rng);
+
+        if (mine_sweeper_board_generator_build(instance, &config, board_seed, &budget, false, 0, &attempts) !=
+                MineSweeperBoardGeneratorStateDone ||
+            !mine_sweeper_board_pool_push(
+                    instance->board, config.width, config.height, config.difficulty, board_seed, &instance->is_canceled)) {
+            break;
+        }
+
+        count++;
+    }
+
+    FURI_LOG_D(MINESWEEPER_GENERATOR_TAG, "Pool has %u boards after %lu attempts", count, attempts);
+}
+
+static int32_t mine_sweeper_board_generator_worker(void* context) {
+    furi_assert(context);
+    MineSweeperBoardGenerator* instance = context;
+
+    // Its own stack is allocated by now, so this is what is left of MINESWEEPER_BOARD_HEAP_RESERVE and beyond
+    FURI_LOG_D(
+            MINESWEEPER_GENERATOR_TAG,
+            "Worker started with %zu bytes of heap free, largest block %zu",
+            memmgr_get_free_heap(),
+            memmgr_heap_get_max_free_block());
+
+    if (instance->is_refill_job) {
+        mine_sweeper_board_generator_refill(instance);
+        return 0;
+    }
+
+    const MineSweeperBoardConfig config = instance->config;
+    const MineSweeperBoardBudget budget = instance->progress.budget;
+    const uint32_t start_tick = furi_get_tick();
+    uint32_t attempts = 0;
+
+    MineSweeperBoardGeneratorState state;
+
+    if (mine_sweeper_board_config_has_band(&config) && (budget.max_attempts != 0 || budget.max_ms != 0)) {
+        // A band may hold no board at all, so it only gets the first half of the budget.
+        // The rest goes to a board without the band, which is still taken as the board for the job
+        const MineSweeperBoardBudget band_budget = {
+            .max_attempts = (budget.max_attempts + 1) / 2,
+            .max_ms = (budget.max_ms + 1) / 2,
+        };
+
+        state = mine_sweeper_board_generator_build(
+                instance, &config, instance->seed, &band_budget, true, start_tick, &attempts);
+
+        if (state == MineSweeperBoardGeneratorStateFailed) {
+            const uint32_t elapsed_ms = (furi_get_tick() - start_tick) * 1000 / furi_kernel_get_tick_frequency();
+            const MineSweeperBoardBudget rest_budget = {
+                .max_attempts = (budget.max_attempts != 0) ? budget.max_attempts - attempts : 0,
+                .max_ms = (budget.max_ms == 0) ? 0 : (elapsed_ms < budget.max_ms) ? budget.max_ms - elapsed_ms : 1,
+            };
+
+            MineSweeperBoardConfig unbanded_config = config;
+            unbanded_config.min_3bv = 0;
+            unbanded_config.max_3bv = 0;
+            unbanded_config.min_difficulty = (MineSweeperBoardDifficulty){0};
+            unbanded_config.max_difficulty = (MineSweeperBoardDifficulty){0};
+
+            FURI_LOG_D(MINESWEEPER_GENERATOR_TAG, "No board in the band after %lu attempts, dropping it", attempts);
+
+            state = mine_sweeper_board_generator_build(
+                    instance, &unbanded_config, instance->seed, &rest_budget, true, start_tick, &attempts);
+        }
+    } else {
+        state = mine_sweeper_board_generator_build(instance, &config, instance->seed, &budget, true, start_tick, &attempts);
+    }
+
+    FURI_LOG_D(MINESWEEPER_GENERATOR_TAG, "Job ended in state %d after %lu attempts", state, attempts);
+
+    mine_sweeper_board_generator_report(instance, state, attempts, furi_get_tick() - start_tick);
+
+    return 0;
+}
+
+/**
+ * Sizes the private board and the engine scratch memory for the board of a job.
+ * The scratch is the worker's, so this runs on the calling thread only while the worker is stopped.
+ *
+ * Returns false if either does not fit in the heap.
+ */
+static bool mine_sweeper_board_generator_reserve(
+        MineSweeperBoardGenerator* instance,
+        const MineSweeperBoardConfig* config) {
+
+    furi_check(furi_thread_get_state(instance->thread) == FuriThreadStateStopped);
+
+    return resize_board(&instance->board, &instance->board_size, config->width, config->height) &&
+           reserve_board_scratch(config->width, config->height);
+}
+
+MineSweeperBoardGenerator* mine_sweeper_board_generator_alloc(void) {
+    MineSweeperBoardGenerator* instance = malloc(sizeof(MineSweeperBoardGenerator));
+
+    instance->board = NULL;
+    instance->board_size = 0;
+    instance->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    instance->callback_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    instance->num_mines = 0;
+    instance->seed = 0;
+    instance->callback = NULL;
+    instance->callback_context = NULL;
+    instance->is_canceled = false;
+    instance->is_refill_job = false;
+    memset(&instance->progress, 0, sizeof(instance->progress));
+    instance->progress.state = MineSweeperBoardGeneratorStateIdle;
+
+    instance->thread = furi_thread_alloc_ex(
+            MINESWEEPER_GENERATOR_TAG,
+            MINESWEEPER_BOARD_GENERATOR_STACK_SIZE,
+            mine_sweeper_board_generator_worker,
+            instance);
+
+    // Background work should never get in the way of drawing and input
+    furi_thread_set_priority(instance->thread, FuriThreadPriorityLow);
+
+    return instance;
+}
+
+void mine_sweeper_board_generator_free(MineSweeperBoardGenerator* instance) {
+    furi_assert(instance);
+
+    mine_sweeper_board_generator_set_callback(instance, NULL, NULL);
+    mine_sweeper_board_generator_cancel(instance);
+
+    furi_thread_free(instance->thread);
+    furi_mutex_free(instance->mutex);
+    furi_mutex_free(instance->callback_mutex);
+    free_board(&instance->board, &instance->board_size);
+    free(instance);
+}
+
+void mine_sweeper_board_generator_set_callback(
+        MineSweeperBoardGenerator* instance,
+        MineSweeperBoardGeneratorCallback callback,
+        void* context) {
+
+    furi_assert(instance);
+
+    furi_mutex_acquire(instance->callback_mutex, FuriWaitForever);
+    instance->callback = callback;
+    instance->callback_context = context;
+    furi_mutex_release(instance->callback_mutex);
+}
+
+void mine_sweeper_board_generator_cancel(MineSweeperBoardGenerator* instance) {
+    furi_assert(instance);
+
+    instance->is_canceled = true;
+    furi_thread_join(instance->thread);
+    instance->is_canceled = false;
+
+    furi_mutex_acquire(instance->mutex, FuriWaitForever);
+    instance->progress.state = MineSweeperBoardGeneratorStateIdle;
+    furi_mutex_release(instance->mutex);
+}
+
+void mine_sweeper_board_generator_start(
+        MineSweeperBoardGenerator* instance,
+        const MineSweeperBoardConfig* config,
+        uint64_t seed,
+        const MineSweeperBoardBudget* budget) {
+
+    furi_assert(instance);
+    furi_assert(config);
+
+    mine_sweeper_board_generator_cancel(instance);
+
+    instance->config = *config;
+    instance->seed = seed;
+    instance->is_refill_job = false;
+
+    const bool is_reserved = mine_sweeper_board_generator_reserve(instance, config);
+
+    furi_mutex_acquire(instance->mutex, FuriWaitForever);
+    instance->progress.state = is_reserved ? MineSweeperBoardGeneratorStateRunning : MineSweeperBoardGeneratorStateFailed;
+    instance->progress.attempts = 0;
+    instance->progress.elapsed_ticks = 0;
+    instance->progress.budget = (budget != NULL) ? *budget : (MineSweeperBoardBudget){0};
+    furi_mutex_release(instance->mutex);
+
+    if (!is_reserved) {
+        FURI_LOG_W(MINESWEEPER_GENERATOR_TAG, "No memory for a %ux%u board", config->width, config->height);
+        return;
+    }
+
+    furi_thread_start(instance->thread);
+}
+
+void mine_sweeper_board_generator_start_refill(
+        MineSweeperBoardGenerator* instance,
+        const MineSweeperBoardConfig* config,
+        uint64_t seed) {
+
+    furi_assert(instance);
+    furi_assert(config);
+
+    mine_sweeper_board_generator_cancel(instance);
+
+    if (!mine_sweeper_board_config_is_poolable(config) || !mine_sweeper_board_generator_reserve(instance, config)) {
+        return;
+    }
+
+    // The progress stays idle as there is no board to take from this job
+    instance->config = *config;
+    instance->seed = seed;
+    instance->is_refill_job = true;
+
+    furi_thread_start(instance->thread);
+}
+
+bool mine_sweeper_board_generator_take_pooled(
+        MineSweeperBoardGenerator* instance,
+        const MineSweeperBoardConfig* config) {
+
+    furi_assert(instance);
+    furi_assert(config);
+
+    if (!mine_sweeper_board_config_is_poolable(config)) {
+        return false;
+    }
+
+    // Also stops a refill, the pool file is only used by one thread at a time
+    mine_sweeper_board_generator_cancel(instance);
+
+    if (!mine_sweeper_board_generator_reserve(instance, config)) {
+        return false;
+    }
+
+    uint16_t num_mines = 0;
+    uint64_t seed = 0;
+
+    if (!mine_sweeper_board_pool_pop(
+            instance->board, config->width, config->height, config->difficulty, &num_mines, &seed)) {
+        return false;
+    }
+
+    instance->config = *config;
+    instance->seed = seed;
+    instance->num_mines = num_mines;
+
+    furi_mutex_acquire(instance->mutex, FuriWaitForever);
+    instance->progress.state = MineSweeperBoardGeneratorStateDone;
+    instance->progress.attempts = 0;
+    instance->progress.elapsed_ticks = 0;
+    instance->progress.budget = (MineSweeperBoardBudget){0};
+    furi_mutex_release(instance->mutex);
+
+    return true;
+}
+
+bool mine_sweeper_board_generator_get_job(
+        MineSweeperBoardGenerator* instance,
+        MineSweeperBoardConfig* config,
+        uint64_t* seed) {
+
+    furi_assert(instance);
+
+    MineSweeperBoardGeneratorState state = mine_sweeper_board_generator_get_progress(instance).state;
+
+    if (state != MineSweeperBoardGeneratorStateRunning && state != MineSweeperBoardGeneratorStateDone) {
+        return false;
+    }
+
+    if (config != NULL) *config = instance->config;
+    if (seed != NULL) *seed = instance->seed;
+
+    return true;
+}
+
+MineSweeperBoardGeneratorProgress mine_sweeper_board_generator_get_progress(MineSweeperBoardGenerator* instance) {
+    furi_assert(instance);
+
+    furi_mutex_acquire(instance->mutex, FuriWaitForever);
+    MineSweeperBoardGeneratorProgress progress = instance->progress;
+    furi_mutex_release(instance->mutex);
+
+    return progress;
+}
+
+void mine_sweeper_board_generator_wait(MineSweeperBoardGenerator* instance) {
+    furi_assert(instance);
+
+    furi_thread_join(instance->thread);
+}
+
+MineSweeperTile* mine_sweeper_board_generator_swap(
+        MineSweeperBoardGenerator* instance,
+        MineSweeperTile* board,
+        uint16_t* board_size,
+        uint16_t* num_mines) {
+
+    furi_assert(instance);
+    furi_assert(board_size);
+    furi_assert(furi_thread_get_state(instance->thread) == FuriThreadStateStopped);
+
+    furi_mutex_acquire(instance->mutex, FuriWaitForever);
+    furi_assert(instance->progress.state == MineSweeperBoardGeneratorStateDone);
+    instance->progress.state = MineSweeperBoardGeneratorStateIdle;
+    furi_mutex_release(instance->mutex);
+
+    MineSweeperTile* ready_board = instance->board;
+    const uint16_t ready_board_size = instance->board_size;
+    instance->board = board;
+    instance->board_size = *board_size;
+    *board_size = ready_board_size;
+
+    if (num_mines != NULL) *num_mines = instance->num_mines;
+
+    return ready_board;
+}
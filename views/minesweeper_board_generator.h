@@ -0,0 +1,239 @@
+/**
+ * @file minesweeper_board_generator.h
+ * Background board generation for the game screen
+ *
+ * Boards are built on a worker thread into a private buffer, so the next
+ * board can be prepared while the current game is played and swapped in
+ * when the game restarts. A job can be given an attempt/time budget,
+ * reports its progress through a callback and can be canceled.
+ *
+ * Verified boards with safe corners are also kept in a pool on the SD card,
+ * which the generator refills when it has nothing else to do.
+ */
+
+#ifndef MINESWEEPER_BOARD_GENERATOR_H
+#define MINESWEEPER_BOARD_GENERATOR_H
+
+#include "minesweeper_engine.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Settings a board is generated for */
+typedef struct {
+    uint8_t width, height, difficulty;
+    bool ensure_solvable;
+    bool has_first_move;    // Board is built around first_move instead of keeping the corners free
+    Point first_move;
+    uint16_t min_3bv, max_3bv;  // Only boards with a 3BV in this band are accepted, 0 leaves that end open
+    // Only boards whose verifier passes, largest frontier and deepest rule are in this band are accepted,
+    // 0 leaves that end open. Boards are always verified when this is set
+    MineSweeperBoardDifficulty min_difficulty, max_difficulty;
+} MineSweeperBoardConfig;
+
+/** Limits for a job, 0 means unbounded */
+typedef struct {
+    uint32_t max_attempts;
+    uint32_t max_ms;
+} MineSweeperBoardBudget;
+
+typedef enum {
+    MineSweeperBoardGeneratorStateIdle,
+    MineSweeperBoardGeneratorStateRunning,
+    MineSweeperBoardGeneratorStateDone,
+    MineSweeperBoardGeneratorStateCanceled,
+    MineSweeperBoardGeneratorStateFailed,     // Budget ran out before a valid board was found
+} MineSweeperBoardGeneratorState;
+
+typedef struct {
+    MineSweeperBoardGeneratorState state;
+    uint32_t attempts;
+    uint32_t elapsed_ticks;
+    MineSweeperBoardBudget budget;
+} MineSweeperBoardGeneratorProgress;
+
+/** Progress callback
+ * @warning     comes from the worker thread, called periodically while running and once when the job ends
+ */
+typedef void (*MineSweeperBoardGeneratorCallback)(const MineSweeperBoardGeneratorProgress* progress, void* context);
+
+/** MineSweeperBoardGenerator anonymous structure */
+typedef struct MineSweeperBoardGenerator MineSweeperBoardGenerator;
+
+static inline bool mine_sweeper_board_difficulty_equal(
+        const MineSweeperBoardDifficulty* a,
+        const MineSweeperBoardDifficulty* b) {
+
+    return a->passes == b->passes &&
+           a->largest_frontier == b->largest_frontier &&
+           a->deepest_rule == b->deepest_rule;
+}
+
+static inline bool mine_sweeper_board_config_equal(
+        const MineSweeperBoardConfig* a,
+        const MineSweeperBoardConfig* b) {
+
+    return a->width == b->width &&
+           a->height == b->height &&
+           a->difficulty == b->difficulty &&
+           a->ensure_solvable == b->ensure_solvable &&
+           a->has_first_move == b->has_first_move &&
+           (!a->has_first_move || (a->first_move.x == b->first_move.x && a->first_move.y == b->first_move.y)) &&
+           a->min_3bv == b->min_3bv &&
+           a->max_3bv == b->max_3bv &&
+           mine_sweeper_board_difficulty_equal(&a->min_difficulty, &b->min_difficulty) &&
+           mine_sweeper_board_difficulty_equal(&a->max_difficulty, &b->max_difficulty);
+}
+
+static inline bool mine_sweeper_board_config_has_3bv_band(const MineSweeperBoardConfig* config) {
+    return config->min_3bv != 0 || config->max_3bv != 0;
+}
+
+static inline bool mine_sweeper_board_config_has_difficulty_band(const MineSweeperBoardConfig* config) {
+    const MineSweeperBoardDifficulty none = {0};
+
+    return !mine_sweeper_board_difficulty_equal(&config->min_difficulty, &none) ||
+           !mine_sweeper_board_difficulty_equal(&config->max_difficulty, &none);
+}
+
+/** There may be no board at all in a band, so jobs for banded settings should always have a budget */
+static inline bool mine_sweeper_board_config_has_band(const MineSweeperBoardConfig* config) {
+    return mine_sweeper_board_config_has_3bv_band(config) || mine_sweeper_board_config_has_difficulty_band(config);
+}
+
+/** Only verified boards with safe corners are worth keeping in the SD card pool,
+ * the others are quick to build and boards around a first move cannot be made in advance.
+ * Pooled boards are not filtered by 3BV or difficulty, so settings with a band are left out as well
+ */
+static inline bool mine_sweeper_board_config_is_poolable(const MineSweeperBoardConfig* config) {
+    return config->ensure_solvable && !config->has_first_move && !mine_sweeper_board_config_has_band(config);
+}
+
+/** Allocate and initialize
+ *
+ * @return      MineSweeperBoardGenerator* instance
+ */
+MineSweeperBoardGenerator* mine_sweeper_board_generator_alloc(void);
+
+/** Cancel any job in progress and free
+ *
+ * @param       instance    MineSweeperBoardGenerator* instance
+ */
+void mine_sweeper_board_generator_free(MineSweeperBoardGenerator* instance);
+
+/** Set the progress callback
+ *
+ * Once this returns the previous callback will not be called anymore.
+ *
+ * @param       instance    MineSweeperBoardGenerator* instance
+ * @param       callback    MineSweeperBoardGeneratorCallback callback, can be NULL
+ * @param       context     void* context for callback
+ */
+void mine_sweeper_board_generator_set_callback(
+        MineSweeperBoardGenerator* instance,
+        MineSweeperBoardGeneratorCallback callback,
+        void* context);
+
+/** Start building a board in the background
+ *
+ * Any job that is still in progress is canceled first. The job fails right away
+ * if the memory for a board of this size can not be allocated.
+ *
+ * @param       instance    MineSweeperBoardGenerator* instance
+ * @param       config      MineSweeperBoardConfig* settings for the board
+ * @param       seed        uint64_t seed for the board
+ * @param       budget      MineSweeperBoardBudget* limits for the job, NULL for unbounded
+ */
+void mine_sweeper_board_generator_start(
+        MineSweeperBoardGenerator* instance,
+        const MineSweeperBoardConfig* config,
+        uint64_t seed,
+        const MineSweeperBoardBudget* budget);
+
+/** Fill the SD card pool for these settings in the background
+ *
+ * Any job that is still in progress is canceled first. Nothing is started for settings
+ * that are not poolable. The job keeps the progress idle and has no board to take.
+ *
+ * @param       instance    MineSweeperBoardGenerator* instance
+ * @param       config      MineSweeperBoardConfig* settings for the pool
+ * @param       seed        uint64_t seed the board seeds are drawn from
+ */
+void mine_sweeper_board_generator_start_refill(
+        MineSweeperBoardGenerator* instance,
+        const MineSweeperBoardConfig* config,
+        uint64_t seed);
+
+/** Take a board from the SD card pool
+ *
+ * Any job that is still in progress is canceled first. On success the job is
+ * done with the pooled board, ready to be swapped out.
+ *
+ * @param       instance    MineSweeperBoardGenerator* instance
+ * @param       config      MineSweeperBoardConfig* settings for the board
+ *
+ * @return      true if the pool had a board for these settings
+ */
+bool mine_sweeper_board_generator_take_pooled(
+        MineSweeperBoardGenerator* instance,
+        const MineSweeperBoardConfig* config);
+
+/** Cancel the job in progress, blocks until the worker has stopped
+ *
+ * @param       instance    MineSweeperBoardGenerator* instance
+ */
+void mine_sweeper_board_generator_cancel(MineSweeperBoardGenerator* instance);
+
+/** Get the running or finished job that has not been taken yet
+ *
+ * @param       instance    MineSweeperBoardGenerator* instance
+ * @param       config      MineSweeperBoardConfig* set to the settings of the job, can be NULL
+ * @param       seed        uint64_t* set to the seed of the job, can be NULL
+ *
+ * @return      true if there is a running or finished job
+ */
+bool mine_sweeper_board_generator_get_job(
+        MineSweeperBoardGenerator* instance,
+        MineSweeperBoardConfig* config,
+        uint64_t* seed);
+
+/** Get a snapshot of the progress of the current job
+ *
+ * @param       instance    MineSweeperBoardGenerator* instance
+ *
+ * @return      MineSweeperBoardGeneratorProgress snapshot
+ */
+MineSweeperBoardGeneratorProgress mine_sweeper_board_generator_get_progress(MineSweeperBoardGenerator* instance);
+
+/** Block until the current job has ended
+ *
+ * @param       instance    MineSweeperBoardGenerator* instance
+ */
+void mine_sweeper_board_generator_wait(MineSweeperBoardGenerator* instance);
+
+/** Take the finished board
+ *
+ * The passed in buffer is handed to the generator as its next private buffer
+ * and the buffer holding the finished board is returned, so no tiles are copied.
+ * The buffers can have different sizes, the generator resizes its buffer for each job.
+ * The job must be in the done state.
+ *
+ * @param       instance    MineSweeperBoardGenerator* instance
+ * @param       board       MineSweeperTile* buffer to give to the generator, can be NULL
+ * @param       board_size  uint16_t* tiles in board, set to the tiles in the returned buffer
+ * @param       num_mines   uint16_t* set to the number of mines on the board
+ *
+ * @return      MineSweeperTile* buffer holding the finished board
+ */
+MineSweeperTile* mine_sweeper_board_generator_swap(
+        MineSweeperBoardGenerator* instance,
+        MineSweeperTile* board,
+        uint16_t* board_size,
+        uint16_t* num_mines);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,1941 @@
+#include "minesweeper_engine.h"
+
+#include <stdatomic.h>
+
+#ifdef MINESWEEPER_ENGINE_BITBOARD
+#include "minesweeper_bitboard.h"
+#endif
+
+const Icon* const tile_icons[13] = {
+    &I_tile_empty_8x8,
+    &I_tile_0_8x8,
+    &I_tile_1_8x8,
+    &I_tile_2_8x8,
+    &I_tile_3_8x8,
+    &I_tile_4_8x8,
+    &I_tile_5_8x8,
+    &I_tile_6_8x8,
+    &I_tile_7_8x8,
+    &I_tile_8_8x8,
+    &I_tile_mine_8x8,
+    &I_tile_flag_8x8,
+    &I_tile_uncleared_8x8,
+};
+
+#ifdef MINESWEEPER_STACK_AUDIT
+#define MINESWEEPER_ENGINE_TAG "Mine Sweeper Engine"
+
+typedef enum {
+    MineSweeperStackAuditSetupBoard,
+    MineSweeperStackAuditVerifier,
+    MineSweeperStackAuditBoard3bv,
+    MineSweeperStackAuditTileClear,
+    MineSweeperStackAuditCount,
+} MineSweeperStackAuditPoint;
+
+static const char* const stack_audit_names[MineSweeperStackAuditCount] = {
+    "setup_board",
+    "check_board_with_verifier",
+    "get_board_3bv",
+    "bfs_tile_clear",
+};
+
+// Least untouched stack seen after each entry point, 0 until it first runs.
+// Only a firmware build logs numbers for the device. The host stand-in in tests/host always reports 1024 bytes,
+// and -fstack-usage on a host build gives x86-64 frame sizes, which say nothing about the ARM frames
+static uint32_t stack_audit_lowest[MineSweeperStackAuditCount];
+
+/**
+ * Logs the stack high water mark of the calling thread if it is lower than the last one logged for point.
+ * The mark covers everything the entry point called before returning, so it is checked at the end.
+ */
+static void mine_sweeper_engine_stack_audit(const MineSweeperStackAuditPoint point) {
+    const FuriThreadId thread_id = furi_thread_get_current_id();
+    const uint32_t stack_space = furi_thread_get_stack_space(thread_id);
+
+    if (stack_audit_lowest[point] == 0 || stack_space < stack_audit_lowest[point]) {
+        stack_audit_lowest[point] = stack_space;
+
+        FURI_LOG_I(
+                MINESWEEPER_ENGINE_TAG,
+                "%s on %s: %lu bytes of stack never used",
+                stack_audit_names[point],
+                furi_thread_get_name(thread_id),
+                stack_space);
+    }
+}
+#else
+#define mine_sweeper_engine_stack_audit(point)
+#endif
+
+// Multipliers for ratio of mines to tiles
+static const float difficulty_multiplier[3] = {
+    0.15f,
+    0.17f,
+    0.19f,
+};
+
+// Scratch memory sized by reserve_board_scratch, one block split up into the arrays below.
+// The scratch, the arrays in it and generation_geometry belong to the board generator: setup_board, the verifier
+// and get_board_3bv run on its worker. The game screen counts 3BV with get_live_board_3bv on its own visited set
+// and queue, and unpack_board_mines builds its own neighbor table, so the GUI thread never runs on the scratch.
+// It only resizes it through the generator, which checks that the worker is stopped first.
+// The entry points claim the scratch for their thread while they run, so a second thread stops at a furi_check
+static _Atomic(FuriThreadId) scratch_owner = NULL;
+static uint8_t* board_scratch = NULL;
+static uint8_t scratch_width = 0;
+static uint8_t scratch_height = 0;
+static size_t scratch_size = 0;
+
+// Cells that may hold a mine, shuffled in place by setup_board
+static uint16_t* mine_candidates;
+
+// Mines next to the stuck frontier and the cells they can be moved to, used by the verifier repair
+static uint16_t* repair_sources;
+static uint16_t* repair_targets;
+
+// Tile states of the verifier, 2 bits per tile so it solves on top of the board without touching its tiles
+static uint8_t* verifier_states;
+
+#ifdef MINESWEEPER_ENGINE_BITBOARD
+// Mines placed by setup_board in rows of bits, numbered all at once when every mine is placed
+static uint32_t* setup_mines;
+#endif
+
+// Cleared numbered tiles the verifier still has to decide, in the order it looks at them.
+// Every tile is pushed once when it is cleared, and a repair pushes the cleared tiles around the
+// mines it moves again, 9 around each end of a move, so the ring has room for those on top of every tile
+#define VERIFIER_REPAIR_EDGES (MINESWEEPER_VERIFIER_MAX_REPAIRS * MINESWEEPER_VERIFIER_REPAIR_MINES * 2 * 9)
+static MineSweeperTileQueue verifier_edges;
+
+// Tiles queued by the current flood of the verifier, and the queue itself which shares the memory of mine_candidates
+static MineSweeperVisitedSet generation_visited;
+static MineSweeperTileQueue generation_queue;
+
+// Board buffers allocated by resize_board, counted as free by is_board_in_memory_budget
+static size_t board_memory = 0;
+
+// Neighbor table of the board being generated, verified or scored, shared by all of the engine helpers.
+// It is only rebuilt when a board of another size comes in
+static MineSweeperBoardGeometry generation_geometry;
+
+// Tile that fills the ring around every board
+static const MineSweeperTile border_tile = {
+    .tile_type = MineSweeperGameScreenTileNone,
+    .tile_state = MineSweeperGameScreenTileStateBorder,
+};
+
+// Takes the scratch for the calling thread, fails if another entry point is still using it
+static void claim_board_scratch(void) {
+    FuriThreadId expected = NULL;
+
+    furi_check(atomic_compare_exchange_strong(&scratch_owner, &expected, furi_thread_get_current_id()));
+}
+
+static void release_board_scratch(void) {
+    furi_check(atomic_load(&scratch_owner) == furi_thread_get_current_id());
+
+    atomic_store(&scratch_owner, NULL);
+}
+
+static inline MineSweeperGameScreenTileState get_verifier_state(const uint16_t pos_1d) {
+    return (MineSweeperGameScreenTileState)((verifier_states[pos_1d >> 2] >> ((pos_1d & 3) << 1)) & 3);
+}
+
+static inline void set_verifier_state(const uint16_t pos_1d, const MineSweeperGameScreenTileState tile_state) {
+    const uint8_t shift = (pos_1d & 3) << 1;
+    verifier_states[pos_1d >> 2] = (verifier_states[pos_1d >> 2] & ~(3 << shift)) | (tile_state << shift);
+}
+
+static void reset_verifier_states(const uint8_t board_width, const uint8_t board_height);
+
+static bool is_reserved_position(
+        const int16_t x,
+        const int16_t y,
+        const uint8_t board_width,
+        const uint8_t board_height,
+        const Point* first_move);
+
+static uint8_t count_surrounding_mines(
+        const MineSweeperTile* board,
+        const uint16_t pos_1d);
+
+static void set_board_border(MineSweeperTile* board, const uint8_t board_width, const uint8_t board_height);
+
+static void place_mine(
+        MineSweeperTile* board,
+        const int16_t* neighbor_offsets,
+        const uint16_t pos_1d);
+
+static void recount_surrounding_tiles(
+        MineSweeperTile* board,
+        const uint16_t pos_1d,
+        MineSweeperTileQueue* edges);
+
+static bool repair_stuck_board(
+        MineSweeperTile* board,
+        const uint8_t board_width,
+        const uint8_t board_height,
+        const Point* first_move,
+        MineSweeperTileQueue* edges,
+        MineSweeperRng* rng);
+
+static uint8_t get_hidden_neighbors(
+        const uint16_t pos_1d,
+        uint16_t* hidden,
+        uint8_t* num_flagged);
+
+static bool apply_subset_rule(
+        MineSweeperTile* board,
+        const uint8_t board_width,
+        const uint8_t board_height,
+        MineSweeperTileQueue* edges,
+        uint16_t* total_mines);
+
+static void bfs_tile_clear_verifier(
+        MineSweeperTile* board,
+        const uint8_t board_width,
+        const uint8_t board_height,
+        const uint16_t x,
+        const uint16_t y,
+        MineSweeperTileQueue* edges);
+
+bool set_board_geometry(MineSweeperBoardGeometry* geometry, const uint8_t board_width, const uint8_t board_height) {
+    furi_assert(geometry);
+
+    if (geometry->width == board_width && geometry->height == board_height) {
+        return false;
+    }
+
+    geometry->width = board_width;
+    geometry->height = board_height;
+
+    for (uint8_t j = 0; j < 8; j++) {
+        geometry->neighbor_offsets[j] = offsets[j][0] * (int16_t)MINESWEEPER_BOARD_STRIDE(board_width) + offsets[j][1];
+    }
+
+    return true;
+}
+
+static uint16_t get_visited_set_words(const uint8_t board_width, const uint8_t board_height) {
+    return (MINESWEEPER_BOARD_STORAGE_SIZE(board_width, board_height) + 31) / 32;
+}
+
+// The generations are padded to a whole word, so memory placed after a visited set stays aligned
+static size_t get_visited_set_size(const uint8_t board_width, const uint8_t board_height) {
+    const uint16_t num_words = get_visited_set_words(board_width, board_height);
+
+    return sizeof(uint32_t) * num_words + ((num_words + 3) & ~3);
+}
+
+/**
+ * Points a visited set at memory of get_visited_set_size bytes, the words come first so they stay aligned
+ */
+static void init_visited_set(
+        MineSweeperVisitedSet* visited,
+        void* memory,
+        const uint8_t board_width,
+        const uint8_t board_height) {
+
+    visited->num_words = get_visited_set_words(board_width, board_height);
+    visited->words = memory;
+    visited->generations = (uint8_t*)(visited->words + visited->num_words);
+    visited->generation = 0;
+
+    memset(visited->generations, 0, visited->num_words);
+}
+
+/**
+ * Points a tile queue at memory for capacity indices, the game's queues allocate it and the scratch ones borrow it
+ */
+static void init_tile_queue(MineSweeperTileQueue* queue, uint16_t* indices, const uint16_t capacity) {
+    queue->indices = indices;
+    queue->capacity = capacity;
+    clear_tile_queue(queue);
+}
+
+static size_t get_board_scratch_size(const uint8_t board_width, const uint8_t board_height) {
+    const uint16_t board_tile_count = board_width * board_height;
+
+    const uint16_t storage_size = MINESWEEPER_BOARD_STORAGE_SIZE(board_width, board_height);
+
+    size_t size = get_visited_set_size(board_width, board_height) +
+                  sizeof(uint16_t) * (3 * board_tile_count + VERIFIER_REPAIR_EDGES) + (storage_size + 3) / 4;
+
+#ifdef MINESWEEPER_ENGINE_BITBOARD
+    // The plane goes first, so it is aligned like the rest of the scratch
+    size += sizeof(uint32_t) * ((board_width + 31) / 32) * board_height;
+#endif
+
+    return size;
+}
+
+// Checks one allocation against the heap that is left, memory freed before the check counts as free
+static bool is_allocation_in_budget(const size_t size) {
+    return size + MINESWEEPER_BOARD_HEAP_RESERVE <= memmgr_get_free_heap() &&
+           size <= memmgr_heap_get_max_free_block();
+}
+
+bool resize_board(MineSweeperTile** board, uint16_t* board_size, const uint8_t board_width, const uint8_t board_height) {
+    furi_assert(board);
+    furi_assert(board_size);
+
+    const uint16_t storage_size = MINESWEEPER_BOARD_STORAGE_SIZE(board_width, board_height);
+
+    if (*board != NULL && *board_size == storage_size) {
+        return true;
+    }
+
+    free_board(board, board_size);
+
+    if (!is_allocation_in_budget(sizeof(MineSweeperTile) * storage_size)) {
+        return false;
+    }
+
+    *board = malloc(sizeof(MineSweeperTile) * storage_size);
+    *board_size = storage_size;
+    board_memory += sizeof(MineSweeperTile) * storage_size;
+
+    return true;
+}
+
+void free_board(MineSweeperTile** board, uint16_t* board_size) {
+    furi_assert(board);
+    furi_assert(board_size);
+
+    free(*board);
+    board_memory -= sizeof(MineSweeperTile) * *board_size;
+    *board = NULL;
+    *board_size = 0;
+}
+
+bool reserve_board_scratch(const uint8_t board_width, const uint8_t board_height) {
+    const uint16_t board_tile_count = board_width * board_height;
+
+    furi_check(atomic_load(&scratch_owner) == NULL);
+
+    // The arrays are laid out from the size with the border ring, so two sizes with the same tile count do not share it
+    if (board_scratch != NULL && scratch_width == board_width && scratch_height == board_height) {
+        return true;
+    }
+
+    free_board_scratch();
+
+    const size_t size = get_board_scratch_size(board_width, board_height);
+
+    if (!is_allocation_in_budget(size)) {
+        return false;
+    }
+
+    board_scratch = malloc(size);
+    scratch_width = board_width;
+    scratch_height = board_height;
+    scratch_size = size;
+
+    uint8_t* memory = board_scratch;
+
+#ifdef MINESWEEPER_ENGINE_BITBOARD
+    setup_mines = (uint32_t*)memory;
+    memory += sizeof(uint32_t) * ((board_width + 31) / 32) * board_height;
+#endif
+
+    init_visited_set(&generation_visited, memory, board_width, board_height);
+
+    // The candidates, the repair targets and the flood queue are never needed at the same time
+    mine_candidates = (uint16_t*)(memory + get_visited_set_size(board_width, board_height));
+    repair_targets = mine_candidates;
+    init_tile_queue(&generation_queue, mine_candidates, board_tile_count);
+    repair_sources = mine_candidates + board_tile_count;
+    init_tile_queue(&verifier_edges, repair_sources + board_tile_count, board_tile_count + VERIFIER_REPAIR_EDGES);
+    verifier_states = (uint8_t*)(verifier_edges.indices + verifier_edges.capacity);
+
+    return true;
+}
+
+void free_board_scratch(void) {
+    furi_check(atomic_load(&scratch_owner) == NULL);
+
+    free(board_scratch);
+    board_scratch = NULL;
+    scratch_width = 0;
+    scratch_height = 0;
+    scratch_size = 0;
+}
+
+bool resize_visited_set(MineSweeperVisitedSet* visited, const uint8_t board_width, const uint8_t board_height) {
+    furi_assert(visited);
+
+    if (visited->words != NULL && visited->num_words == get_visited_set_words(board_width, board_height)) {
+        return true;
+    }
+
+    free_visited_set(visited);
+
+    const size_t size = get_visited_set_size(board_width, board_height);
+
+    if (!is_allocation_in_budget(size)) {
+        return false;
+    }
+
+    init_visited_set(visited, malloc(size), board_width, board_height);
+    board_memory += size;
+
+    return true;
+}
+
+void free_visited_set(MineSweeperVisitedSet* visited) {
+    furi_assert(visited);
+
+    free(visited->words);
+    board_memory -= sizeof(uint32_t) * visited->num_words + ((visited->num_words + 3) & ~3);
+    visited->words = NULL;
+    visited->generations = NULL;
+    visited->num_words = 0;
+}
+
+void clear_visited_set(MineSweeperVisitedSet* visited) {
+    furi_assert(visited);
+
+    // Generation 0 is what every word starts out with, so it is skipped when the counter wraps
+    if (++visited->generation == 0) {
+        memset(visited->generations, 0, visited->num_words);
+        visited->generation = 1;
+    }
+}
+
+bool resize_tile_queue(MineSweeperTileQueue* queue, const uint8_t board_width, const uint8_t board_height) {
+    furi_assert(queue);
+
+    const uint16_t board_tile_count = board_width * board_height;
+
+    if (queue->indices != NULL && queue->capacity == board_tile_count) {
+        return true;
+    }
+
+    free_tile_queue(queue);
+
+    if (!is_allocation_in_budget(sizeof(uint16_t) * board_tile_count)) {
+        return false;
+    }
+
+    init_tile_queue(queue, malloc(sizeof(uint16_t) * board_tile_count), board_tile_count);
+    board_memory += sizeof(uint16_t) * board_tile_count;
+
+    return true;
+}
+
+void free_tile_queue(MineSweeperTileQueue* queue) {
+    furi_assert(queue);
+
+    free(queue->indices);
+    board_memory -= sizeof(uint16_t) * queue->capacity;
+    init_tile_queue(queue, NULL, 0);
+}
+
+// Empties the changed rows, the top one is put below the bottom one
+static inline void clear_changed_rows(MineSweeperUnclearedIndex* uncleared) {
+    uncleared->changed_top = UINT8_MAX;
+    uncleared->changed_bottom = 0;
+}
+
+static uint16_t get_frontier_words(const uint8_t board_width, const uint8_t board_height) {
+    return (MINESWEEPER_BOARD_STORAGE_SIZE(board_width, board_height) + 31) / 32;
+}
+
+// Rows of bits the bit plane engine keeps next to the uncleared rows
+#ifdef MINESWEEPER_ENGINE_BITBOARD
+#define UNCLEARED_INDEX_PLANES 5
+#else
+#define UNCLEARED_INDEX_PLANES 1
+#endif
+
+static size_t get_uncleared_index_size(const uint8_t board_width, const uint8_t board_height) {
+    return sizeof(uint32_t) * (UNCLEARED_INDEX_PLANES * ((board_width + 31) / 32) * board_height +
+                               get_frontier_words(board_width, board_height)) +
+           sizeof(uint8_t) * board_height;
+}
+
+bool resize_uncleared_index(MineSweeperUnclearedIndex* uncleared, const uint8_t board_width, const uint8_t board_height) {
+    furi_assert(uncleared);
+
+    if (uncleared->rows != NULL && uncleared->board_width == board_width && uncleared->board_height == board_height) {
+        return true;
+    }
+
+    free_uncleared_index(uncleared);
+
+    const size_t size = get_uncleared_index_size(board_width, board_height);
+
+    if (!is_allocation_in_budget(size)) {
+        return false;
+    }
+
+    // The words of both bitsets come first so the row counts do not break their alignment
+    uncleared->row_words = (board_width + 31) / 32;
+    uncleared->rows = malloc(size);
+    uncleared->frontier = uncleared->rows + uncleared->row_words * board_height;
+    uncleared->row_counts = (uint8_t*)(uncleared->frontier + get_frontier_words(board_width, board_height));
+
+#ifdef MINESWEEPER_ENGINE_BITBOARD
+    uncleared->mines = (uint32_t*)uncleared->row_counts;
+    uncleared->zeros = uncleared->mines + uncleared->row_words * board_height;
+    uncleared->flags = uncleared->zeros + uncleared->row_words * board_height;
+    uncleared->pending = uncleared->flags + uncleared->row_words * board_height;
+    uncleared->row_counts = (uint8_t*)(uncleared->pending + uncleared->row_words * board_height);
+    uncleared->mine_count = 0;
+#endif
+    uncleared->board_width = board_width;
+    uncleared->board_height = board_height;
+    board_memory += size;
+
+    memset(uncleared->rows, 0, size);
+    uncleared->count = 0;
+    uncleared->frontier_count = 0;
+    clear_changed_rows(uncleared);
+
+    return true;
+}
+
+void free_uncleared_index(MineSweeperUnclearedIndex* uncleared) {
+    furi_assert(uncleared);
+
+    if (uncleared->rows != NULL) {
+        free(uncleared->rows);
+        board_memory -= get_uncleared_index_size(uncleared->board_width, uncleared->board_height);
+    }
+
+    uncleared->rows = NULL;
+    uncleared->row_counts = NULL;
+    uncleared->frontier = NULL;
+#ifdef MINESWEEPER_ENGINE_BITBOARD
+    uncleared->mines = NULL;
+    uncleared->zeros = NULL;
+    uncleared->flags = NULL;
+    uncleared->pending = NULL;
+    uncleared->mine_count = 0;
+#endif
+    uncleared->count = 0;
+    uncleared->frontier_count = 0;
+    uncleared->row_words = 0;
+    clear_changed_rows(uncleared);
+    uncleared->board_width = 0;
+    uncleared->board_height = 0;
+}
+
+// A cleared numbered tile is on the frontier while one of its neighbors is uncleared or flagged
+static bool is_frontier_position(
+        const MineSweeperTile* board,
+        const int16_t* neighbor_offsets,
+        const uint16_t pos_1d) {
+
+    const MineSweeperTile tile = board[pos_1d];
+
+    if (tile.tile_state != MineSweeperGameScreenTileStateCleared || tile.tile_type < MineSweeperGameScreenTileOne ||
+        tile.tile_type > MineSweeperGameScreenTileEight) {
+        return false;
+    }
+
+    // The border ring is neither, so it never keeps a tile on the frontier
+    for (uint8_t j = 0; j < 8; j++) {
+        const MineSweeperGameScreenTileState state = board[pos_1d + neighbor_offsets[j]].tile_state;
+
+        if (state == MineSweeperGameScreenTileStateUncleared || state == MineSweeperGameScreenTileStateFlagged) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void set_frontier_tile(MineSweeperUnclearedIndex* uncleared, const uint16_t pos_1d, const bool is_frontier) {
+    if (is_frontier_tile(uncleared, pos_1d) == is_frontier) {
+        return;
+    }
+
+    uncleared->frontier[pos_1d >> 5] ^= (uint32_t)1 << (pos_1d & 31);
+
+    if (is_frontier) {
+        uncleared->frontier_count++;
+    } else {
+        uncleared->frontier_count--;
+    }
+}
+
+void reset_uncleared_index(
+        MineSweeperUnclearedIndex* uncleared,
+        const MineSweeperTile* board,
+        const MineSweeperBoardGeometry* geometry) {
+
+    furi_assert(uncleared);
+    furi_assert(uncleared->rows);
+    furi_assert(board);
+    furi_assert(geometry);
+    furi_assert(geometry->width == uncleared->board_width && geometry->height == uncleared->board_height);
+
+    const uint8_t board_width = uncleared->board_width;
+    const uint8_t board_height = uncleared->board_height;
+
+    memset(uncleared->rows, 0, get_uncleared_index_size(board_width, board_height));
+    uncleared->count = 0;
+    uncleared->frontier_count = 0;
+    clear_changed_rows(uncleared);
+
+    for (uint8_t x = 0; x < board_height; x++) {
+        const uint16_t row_pos_1d = get_board_index(board_width, x, 0);
+        uint32_t* words = &uncleared->rows[x * uncleared->row_words];
+
+        for (uint8_t y = 0; y < board_width; y++) {
+            if (board[row_pos_1d + y].tile_state == MineSweeperGameScreenTileStateUncleared) {
+                words[y >> 5] |= (uint32_t)1 << (y & 31);
+                uncleared->row_counts[x]++;
+            } else if (is_frontier_position(board, geometry->neighbor_offsets, row_pos_1d + y)) {
+                set_frontier_tile(uncleared, row_pos_1d + y, true);
+            }
+        }
+
+        uncleared->count += uncleared->row_counts[x];
+    }
+
+#ifdef MINESWEEPER_ENGINE_BITBOARD
+    reset_bitboard_planes(uncleared, board);
+#endif
+}
+
+void update_uncleared_index(
+        MineSweeperUnclearedIndex* uncleared,
+        const MineSweeperTile* board,
+        const uint16_t pos_1d) {
+
+    furi_assert(uncleared);
+    furi_assert(board);
+
+    const uint16_t stride = MINESWEEPER_BOARD_STRIDE(uncleared->board_width);
+    const uint8_t x = pos_1d / stride - 1;
+    const uint8_t y = pos_1d % stride - 1;
+    const MineSweeperGameScreenTileState tile_state = board[pos_1d].tile_state;
+    const bool is_uncleared = tile_state == MineSweeperGameScreenTileStateUncleared;
+
+    uint32_t* word = &uncleared->rows[x * uncleared->row_words + (y >> 5)];
+    const uint32_t bit = (uint32_t)1 << (y & 31);
+
+    if (((*word & bit) != 0) == is_uncleared) {
+        return;
+    }
+
+    *word ^= bit;
+
+#ifdef MINESWEEPER_ENGINE_BITBOARD
+    set_plane_tile(uncleared->flags, uncleared->row_words, x, y, tile_state == MineSweeperGameScreenTileStateFlagged);
+#endif
+
+    if (is_uncleared) {
+        uncleared->row_counts[x]++;
+        uncleared->count++;
+    } else {
+        uncleared->row_counts[x]--;
+        uncleared->count--;
+    }
+
+    // Flags move tiles between uncleared and flagged, which are both hidden to the frontier
+    if (tile_state != MineSweeperGameScreenTileStateCleared) {
+        return;
+    }
+
+    if (x < uncleared->changed_top) uncleared->changed_top = x;
+    if (x > uncleared->changed_bottom) uncleared->changed_bottom = x;
+
+    // A cleared number is taken onto the frontier until refresh_frontier looks at its neighbors
+    const MineSweeperGameScreenTileType tile_type = board[pos_1d].tile_type;
+
+    if (tile_type >= MineSweeperGameScreenTileOne && tile_type <= MineSweeperGameScreenTileEight) {
+        set_frontier_tile(uncleared, pos_1d, true);
+    }
+}
+
+/**
+ * Every number cleared since the last refresh is already on the frontier, so only frontier tiles
+ * can have to come off it, and only those in the changed rows or next to them. Their bits are walked
+ * a word at a time, so the zeros of a large flood are skipped without reading their tiles.
+ */
+void refresh_frontier(
+        MineSweeperUnclearedIndex* uncleared,
+        const MineSweeperTile* board,
+        const MineSweeperBoardGeometry* geometry) {
+
+    furi_assert(uncleared);
+    furi_assert(board);
+    furi_assert(geometry);
+    furi_assert(geometry->width == uncleared->board_width && geometry->height == uncleared->board_height);
+
+    if (uncleared->changed_top > uncleared->changed_bottom) {
+        return;
+    }
+
+    const uint8_t first_row = (uncleared->changed_top > 0) ? uncleared->changed_top - 1 : 0;
+    const uint8_t last_row = (uncleared->changed_bottom + 1 < geometry->height) ? uncleared->changed_bottom + 1 :
+                                                                                  uncleared->changed_bottom;
+    const uint16_t first_word = get_board_index(geometry->width, first_row, 0) >> 5;
+    const uint16_t last_word = get_board_index(geometry->width, last_row, geometry->width - 1) >> 5;
+
+    // The words at both ends can hold tiles of the rows past the range, looking at those again does no harm
+    for (uint16_t k = first_word; k <= last_word; k++) {
+        uint32_t word = uncleared->frontier[k];
+
+        while (word != 0) {
+            const uint16_t pos_1d = k * 32 + __builtin_ctz(word);
+            word &= word - 1;
+
+            if (!is_frontier_position(board, geometry->neighbor_offsets, pos_1d)) {
+                set_frontier_tile(uncleared, pos_1d, false);
+            }
+        }
+    }
+
+    clear_changed_rows(uncleared);
+}
+
+uint16_t get_next_frontier_tile(const MineSweeperUnclearedIndex* uncleared, const uint16_t pos_1d) {
+    furi_assert(uncleared);
+
+    const uint16_t num_words = get_frontier_words(uncleared->board_width, uncleared->board_height);
+    uint16_t k = pos_1d >> 5;
+
+    if (k >= num_words) {
+        return 0;
+    }
+
+    uint32_t word = uncleared->frontier[k] & (UINT32_MAX << (pos_1d & 31));
+
+    while (word == 0 && ++k < num_words) {
+        word = uncleared->frontier[k];
+    }
+
+    return (word != 0) ? k * 32 + __builtin_ctz(word) : 0;
+}
+
+/**
+ * Gets the column of the set bit in a row closest to column y, the row must have one.
+ * The words are looked at outward from the one holding y, ties go to the left.
+ */
+static uint8_t get_closest_uncleared_column(const uint32_t* row, const uint8_t row_words, const uint8_t y) {
+    const uint8_t start_word = y >> 5;
+    const uint8_t bit = y & 31;
+
+    int16_t left = -1;
+    int16_t right = -1;
+
+    // Bits at and below y in its word, then whole words to the left
+    int16_t k = start_word;
+    uint32_t word = row[k] & ((bit == 31) ? UINT32_MAX : (((uint32_t)1 << (bit + 1)) - 1));
+
+    while (word == 0 && --k >= 0) {
+        word = row[k];
+    }
+
+    if (word != 0) left = k * 32 + 31 - __builtin_clz(word);
+
+    // Bits at and above y in its word, then whole words to the right
+    k = start_word;
+    word = row[k] & (UINT32_MAX << bit);
+
+    while (word == 0 && ++k < row_words) {
+        word = row[k];
+    }
+
+    if (word != 0) right = k * 32 + __builtin_ctz(word);
+
+    if (left < 0) return right;
+    if (right < 0) return left;
+
+    return (y - left <= right - y) ? left : right;
+}
+
+bool find_closest_uncleared_tile(
+        const MineSweeperUnclearedIndex* uncleared,
+        const uint16_t x,
+        const uint16_t y,
+        Point* closest) {
+
+    furi_assert(uncleared);
+    furi_assert(closest);
+    furi_assert(x < uncleared->board_height && y < uncleared->board_width);
+
+    if (uncleared->count == 0) {
+        return false;
+    }
+
+    const uint16_t board_height = uncleared->board_height;
+    uint32_t closest_distance = UINT32_MAX;
+
+    // A row d away can not hold a tile closer than d*d, so the rings stop once that is no better
+    for (uint16_t d = 0; (uint32_t)d * d < closest_distance && (d <= x || x + d < board_height); d++) {
+        for (int8_t side = -1; side <= 1; side += 2) {
+            const int16_t row = x + side * d;
+
+            if (row < 0 || row >= board_height || uncleared->row_counts[row] == 0 || (d == 0 && side > 0)) {
+                continue;
+            }
+
+            const uint8_t column = get_closest_uncleared_column(
+                    &uncleared->rows[row * uncleared->row_words], uncleared->row_words, y);
+            const int16_t dy = column - (int16_t)y;
+            const uint32_t distance = (uint32_t)d * d + dy * dy;
+
+            if (distance < closest_distance) {
+                closest_distance = distance;
+                closest->x = row;
+                closest->y = column;
+            }
+        }
+    }
+
+    return true;
+}
+
+
+bool is_board_in_memory_budget(const uint8_t board_width, const uint8_t board_height) {
+    const size_t size = 2 * sizeof(MineSweeperTile) * MINESWEEPER_BOARD_STORAGE_SIZE(board_width, board_height) +
+                        get_visited_set_size(board_width, board_height) +
+                        sizeof(uint16_t) * board_width * board_height +
+                        get_uncleared_index_size(board_width, board_height) +
+                        get_board_scratch_size(board_width, board_height);
+
+    return size + MINESWEEPER_BOARD_HEAP_RESERVE <= memmgr_get_free_heap() + board_memory + scratch_size;
+}
+
+uint16_t get_board_mine_count(const uint8_t board_width, const uint8_t board_height, const uint8_t board_difficulty) {
+    return (uint16_t)(board_width * board_height) * difficulty_multiplier[ board_difficulty ];
+}
+
+/**
+ * This function is called for every generation attempt.
+ * It sets up a random board to be checked by the verifier, drawing
+ * all of its randomness from the passed in generator
+ */
+uint16_t setup_board(
+        MineSweeperTile* board,
+        const uint8_t board_width,
+        const uint8_t board_height,
+        const uint8_t board_difficulty,
+        const Point* first_move,
+        MineSweeperRng* rng) {
+
+    furi_assert(board);
+    furi_assert(scratch_width == board_width && scratch_height == board_height);
+    furi_assert(rng);
+
+    claim_board_scratch();
+
+    uint16_t num_mines = get_board_mine_count(board_width, board_height, board_difficulty);
+
+    set_board_geometry(&generation_geometry, board_width, board_height);
+
+#ifdef MINESWEEPER_ENGINE_BITBOARD
+    const uint16_t stride = MINESWEEPER_BOARD_STRIDE(board_width);
+    const uint8_t row_words = (board_width + 31) / 32;
+
+    // Mines go into a plane and the whole board is numbered from it once they are all placed
+    memset(setup_mines, 0, sizeof(uint32_t) * row_words * board_height);
+#else
+    // Every tile starts as an uncleared zero and the numbers are counted up as the mines are placed
+    clear_board(board, board_width, board_height, MineSweeperGameScreenTileZero);
+#endif
+
+    // Collect every cell that can hold a mine, leaving out the tiles the game starts from.
+    // Reserved tiles are only in the rows around the first move or in the corner rows, every other row is taken whole
+    uint16_t candidate_count = 0;
+    for (uint8_t x = 0; x < board_height; x++) {
+        const uint16_t row_pos_1d = get_board_index(board_width, x, 0);
+        const bool has_reserved = (first_move != NULL) ? abs(x - (int16_t)first_move->x) <= 1 :
+                                                         (x <= 1 || x == board_height - 1);
+
+        for (uint8_t y = 0; y < board_width; y++) {
+            if (!has_reserved || !is_reserved_position(x, y, board_width, board_height, first_move)) {
+                mine_candidates[candidate_count++] = row_pos_1d + y;
+            }
+        }
+    }
+
+    furi_assert(num_mines <= candidate_count);
+
+    // Partial Fisher-Yates shuffle: each mine takes exactly one random draw
+    // from the candidates that have not been picked yet, so there is no retry loop.
+    // This fixes the number of draws, it is not faster: building the candidates costs
+    // about what the redraws did, see tests/host/bench_setup_board.c
+    for (uint16_t i = 0; i < num_mines; i++) {
+        uint16_t j = i + mine_sweeper_rng_range(rng, candidate_count - i);
+
+        uint16_t rand_pos = mine_candidates[j];
+        mine_candidates[j] = mine_candidates[i];
+        mine_candidates[i] = rand_pos;
+
+#ifdef MINESWEEPER_ENGINE_BITBOARD
+        set_plane_tile(setup_mines, row_words, rand_pos / stride - 1, rand_pos % stride - 1, true);
+#else
+        place_mine(board, generation_geometry.neighbor_offsets, rand_pos);
+#endif
+    }
+
+#ifdef MINESWEEPER_ENGINE_BITBOARD
+    number_board_from_mines(setup_mines, board, board_width, board_height);
+#endif
+
+    // Placing mines counts them into the border tiles as well, rewriting the ring is cheaper than checking for it.
+    // Numbering from the plane never writes the ring, so it is put there in that build too
+    set_board_border(board, board_width, board_height);
+
+    mine_sweeper_engine_stack_audit(MineSweeperStackAuditSetupBoard);
+
+    release_board_scratch();
+
+    return num_mines;
+}
+
+void pack_board_mines(
+        const MineSweeperTile* board,
+        const uint8_t board_width,
+        const uint8_t board_height,
+        uint8_t* mine_bits) {
+
+    furi_assert(board);
+    furi_assert(mine_bits);
+
+    memset(mine_bits, 0, MINESWEEPER_BOARD_MINE_BITS_SIZE(board_width, board_height));
+
+    // Bits are in row order without the border, so stored layouts do not depend on the buffer layout
+    uint16_t i = 0;
+
+    for (uint8_t x = 0; x < board_height; x++) {
+        for (uint8_t y = 0; y < board_width; y++, i++) {
+            if (board[get_board_index(board_width, x, y)].tile_type == MineSweeperGameScreenTileMine) {
+                mine_bits[i >> 3] |= (uint8_t)(1 << (i & 7));
+            }
+        }
+    }
+}
+
+uint16_t unpack_board_mines(
+        MineSweeperTile* board,
+        const uint8_t board_width,
+        const uint8_t board_height,
+        const uint8_t* mine_bits) {
+
+    furi_assert(board);
+    furi_assert(mine_bits);
+
+    uint16_t num_mines = 0;
+    uint16_t i = 0;
+
+    // Boards are taken from the pool on the GUI thread, so it keeps off the scratch and builds its own neighbor table
+    MineSweeperBoardGeometry geometry = {0};
+    set_board_geometry(&geometry, board_width, board_height);
+
+    // Same tile setup as setup_board
+    clear_board(board, board_width, board_height, MineSweeperGameScreenTileZero);
+
+    for (uint8_t x = 0; x < board_height; x++) {
+        for (uint8_t y = 0; y < board_width; y++, i++) {
+            if ((mine_bits[i >> 3] >> (i & 7)) & 1) {
+                place_mine(board, geometry.neighbor_offsets, get_board_index(board_width, x, y));
+                num_mines++;
+            }
+        }
+    }
+
+    set_board_border(board, board_width, board_height);
+
+    return num_mines;
+}
+
+/**
+ *  This function serves as the verifier for a board to check whether it has to be solved ambiguously or not
+ *
+ *  Returns true if it is unambiguously solvable.
+ */
+bool check_board_with_verifier(
+        MineSweeperTile* board,
+        const uint8_t board_width,
+        const uint8_t board_height,
+        uint16_t total_mines,
+        const Point* first_move,
+        MineSweeperRng* rng,
+        MineSweeperBoardDifficulty* difficulty) {
+
+    furi_assert(board);
+    furi_assert(scratch_width == board_width && scratch_height == board_height);
+
+    claim_board_scratch();
+
+    MineSweeperBoardDifficulty score = {0};
+
+    const uint16_t stride = MINESWEEPER_BOARD_STRIDE(board_width);
+
+    // Ring of the edges still to decide
+    MineSweeperTileQueue* edges = &verifier_edges;
+    clear_tile_queue(edges);
+
+    bool is_solvable = false;
+    uint8_t repairs_left = (rng != NULL) ? MINESWEEPER_VERIFIER_MAX_REPAIRS : 0;
+
+    // Starting position is the first move, or 0,0 for a board with safe corners
+    Point start_pos = (first_move != NULL) ? *first_move : (Point){.x = 0, .y = 0};
+
+    set_board_geometry(&generation_geometry, board_width, board_height);
+    const int16_t* neighbor_offsets = generation_geometry.neighbor_offsets;
+
+    // The verifier starts with every tile uncleared no matter what the board states are
+    reset_verifier_states(board_width, board_height);
+
+    // Initially bfs clear from the start as it is safe. We should push all 'edges' found
+    // into the edges and this will be where we start off from
+    bfs_tile_clear_verifier(board, board_width, board_height, start_pos.x, start_pos.y, edges);
+                                                             
+    //While we have valid edges to check and have not solved the board
+    while (!is_solvable && edges->size > 0) {
+
+        bool is_stuck = true; // This variable will track if any flag was placed for any edge to see if we are stuck
+                              
+        uint16_t edge_count = edges->size;
+
+        score.passes++;
+        if (edge_count > score.largest_frontier) {
+            score.largest_frontier = edge_count;
+        }
+
+        // Iterate through all edge tiles and push new ones on
+        while (edge_count-- > 0) {
+
+            // Pop the 1d position in buffer and get the point from it
+            const uint16_t curr_pos_1d = pop_tile_queue(edges);
+            const Point curr_pos = (Point){.x = curr_pos_1d / stride - 1, .y = curr_pos_1d % stride - 1};
+
+            // Get tile at 1d position
+            MineSweeperTile tile = board[curr_pos_1d];
+            uint8_t tile_num = tile.tile_type - 1;
+            
+            // Track total surrounding tiles and flagged tiles
+            uint8_t num_surrounding_tiles = 0;
+            uint8_t num_flagged_tiles = 0;
+
+            // Border tiles are neither uncleared nor flagged, so they are never counted
+            for (uint8_t j = 0; j < 8; j++) {
+                const uint16_t pos_1d = curr_pos_1d + neighbor_offsets[j];
+                if (get_verifier_state(pos_1d) == MineSweeperGameScreenTileStateUncleared) {
+                    num_surrounding_tiles++;
+                } else if (get_verifier_state(pos_1d) == MineSweeperGameScreenTileStateFlagged) {
+                    num_surrounding_tiles++;
+                    num_flagged_tiles++;
+                }
+
+            }
+            
+            if (num_flagged_tiles == tile_num) {
+                
+                // If the tile has the same number of surrounding flags as its type we bfs clear the uncleared surrounding tiles
+                // pushing new unvisited edges on the ring
+
+                for (uint8_t j = 0; j < 8; j++) {
+                    const uint16_t pos_1d = curr_pos_1d + neighbor_offsets[j];
+                    if (get_verifier_state(pos_1d) == MineSweeperGameScreenTileStateUncleared) {
+                        bfs_tile_clear_verifier(
+                                board,
+                                board_width,
+                                board_height,
+                                curr_pos.x + offsets[j][0],
+                                curr_pos.y + offsets[j][1],
+                                edges);
+                    }
+
+                }
+
+                is_stuck = false;
+
+            } else if (num_surrounding_tiles == tile_num) {
+
+                // If the number of surrounding tiles is the tile num it is unambiguous so we place a flag on those tiles,
+                // decrement the mine count appropriately and check win condition, and then mark stuck as false
+
+                for (uint8_t j = 0; j < 8; j++) {
+                    const uint16_t pos_1d = curr_pos_1d + neighbor_offsets[j];
+                    if (get_verifier_state(pos_1d) == MineSweeperGameScreenTileStateUncleared) {
+                        set_verifier_state(pos_1d, MineSweeperGameScreenTileStateFlagged);
+                    }
+                }
+
+                total_mines -= (num_surrounding_tiles - num_flagged_tiles);
+
+                if (total_mines == 0) is_solvable = true;
+                 
+                is_stuck = false;
+
+            } else if (num_surrounding_tiles != 0) {
+
+                // If we have tiles around this position but the number of flagged tiles != tile num
+                // and the surrounding tiles != tile num this means the tile is ambiguous. We can push
+                // it back on the edges to be reprocessed with any other new edges
+                
+                push_tile_queue(edges, curr_pos_1d);
+
+            }
+        }
+        
+        if (!is_stuck) {
+            if (score.deepest_rule < MineSweeperVerifierRuleSingle) {
+                score.deepest_rule = MineSweeperVerifierRuleSingle;
+            }
+
+            continue;
+        }
+
+        // No tile decides anything on its own, so look at overlapping pairs of tiles before giving up
+        if (apply_subset_rule(board, board_width, board_height, edges, &total_mines)) {
+            score.deepest_rule = MineSweeperVerifierRuleSubset;
+
+            if (total_mines == 0) is_solvable = true;
+
+            continue;
+        }
+
+        // If we are still stuck it is an ambiguous map generation. Rather than throwing the whole board away
+        // we try to move the mines around the stuck frontier and carry on from the same position
+        if (repairs_left == 0 || !repair_stuck_board(board, board_width, board_height, first_move, edges, rng)) {
+            break;
+        }
+
+        repairs_left--;
+        score.repairs++;
+    }
+
+    if (difficulty != NULL) {
+        *difficulty = score;
+    }
+
+    mine_sweeper_engine_stack_audit(MineSweeperStackAuditVerifier);
+
+    release_board_scratch();
+
+    return is_solvable;
+
+}
+
+/**
+ * The tiles that never hold a mine to help guarantee solvability.
+ * With a first move these are the first move and its neighbors so it opens a zero region,
+ * otherwise the corners and the tiles next to them.
+ */
+static bool is_reserved_position(
+        const int16_t x,
+        const int16_t y,
+        const uint8_t board_width,
+        const uint8_t board_height,
+        const Point* first_move) {
+
+    if (first_move != NULL) {
+        return abs(x - (int16_t)first_move->x) <= 1 && abs(y - (int16_t)first_move->y) <= 1;
+    }
+
+    return ((x==0 && y==0)                              ||
+            (x==0 && y==1)                              ||
+            (x==1 && y==0)                              ||
+            (x==board_height-1 && y==board_width-1)     ||
+            (x==0 && y==board_width-1)                  ||
+            (x==board_height-1 && y==0));
+}
+
+static uint8_t count_surrounding_mines(
+        const MineSweeperTile* board,
+        const uint16_t pos_1d) {
+
+    const int16_t* neighbor_offsets = generation_geometry.neighbor_offsets;
+
+    uint8_t mine_count = 0;
+
+    for (uint8_t j = 0; j < 8; j++) {
+        if (board[pos_1d + neighbor_offsets[j]].tile_type == MineSweeperGameScreenTileMine) {
+            mine_count++;
+        }
+    }
+
+    return mine_count;
+}
+
+void clear_board(
+        MineSweeperTile* board,
+        const uint8_t board_width,
+        const uint8_t board_height,
+        const MineSweeperGameScreenTileType tile_type) {
+
+    furi_assert(board);
+
+    for (uint8_t x = 0; x < board_height; x++) {
+        MineSweeperTile* row = &board[get_board_index(board_width, x, 0)];
+
+        for (uint8_t y = 0; y < board_width; y++) {
+            row[y].tile_type = tile_type;
+            row[y].tile_state = MineSweeperGameScreenTileStateUncleared;
+        }
+    }
+
+    set_board_border(board, board_width, board_height);
+}
+
+/**
+ * Writes the ring of border tiles around the board
+ */
+static void set_board_border(MineSweeperTile* board, const uint8_t board_width, const uint8_t board_height) {
+    const uint16_t stride = MINESWEEPER_BOARD_STRIDE(board_width);
+    const uint16_t last_row = (board_height + 1) * stride;
+
+    for (uint16_t y = 0; y < stride; y++) {
+        board[y] = border_tile;
+        board[last_row + y] = border_tile;
+    }
+
+    for (uint16_t x = 1; x <= board_height; x++) {
+        board[x * stride] = border_tile;
+        board[x * stride + board_width + 1] = border_tile;
+    }
+}
+
+/**
+ * Sets every verifier state to uncleared and the ring around the board to border.
+ * The uncleared state is 1, so every 2 bit state in 0x55 is uncleared.
+ */
+static void reset_verifier_states(const uint8_t board_width, const uint8_t board_height) {
+    const uint16_t stride = MINESWEEPER_BOARD_STRIDE(board_width);
+    const uint16_t last_row = (board_height + 1) * stride;
+
+    memset(verifier_states, 0x55, (MINESWEEPER_BOARD_STORAGE_SIZE(board_width, board_height) + 3) / 4);
+
+    for (uint16_t y = 0; y < stride; y++) {
+        set_verifier_state(y, MineSweeperGameScreenTileStateBorder);
+        set_verifier_state(last_row + y, MineSweeperGameScreenTileStateBorder);
+    }
+
+    for (uint16_t x = 1; x <= board_height; x++) {
+        set_verifier_state(x * stride, MineSweeperGameScreenTileStateBorder);
+        set_verifier_state(x * stride + board_width + 1, MineSweeperGameScreenTileStateBorder);
+    }
+}
+
+/**
+ * Turns the tile at pos_1d into a mine and counts it in the number of every neighbor that is not a mine,
+ * so a board is numbered with 8 lookups per mine instead of 8 per tile.
+ * A tile that already had its number raised simply has it overwritten when it becomes a mine itself.
+ * Border tiles are counted up as well, callers put the border back once every mine is placed.
+ */
+static void place_mine(
+        MineSweeperTile* board,
+        const int16_t* neighbor_offsets,
+        const uint16_t pos_1d) {
+
+    board[pos_1d].tile_type = MineSweeperGameScreenTileMine;
+
+    for (uint8_t j = 0; j < 8; j++) {
+        MineSweeperTile* tile = &board[pos_1d + neighbor_offsets[j]];
+
+        if (tile->tile_type != MineSweeperGameScreenTileMine) {
+            tile->tile_type++;
+        }
+    }
+}
+
+/**
+ * Recounts the tile at pos_1d and its neighbors after a mine was moved there or away from there.
+ * Cleared tiles whose number changed are pushed on edges so the verifier looks at them again.
+ */
+static void recount_surrounding_tiles(
+        MineSweeperTile* board,
+        const uint16_t pos_1d,
+        MineSweeperTileQueue* edges) {
+
+    const int16_t* neighbor_offsets = generation_geometry.neighbor_offsets;
+
+    for (int8_t i = -1; i < 8; i++) {
+        // -1 is the moved tile itself
+        const uint16_t curr_pos_1d = pos_1d + ((i < 0) ? 0 : neighbor_offsets[i]);
+        MineSweeperTile* tile = &board[curr_pos_1d];
+
+        if (get_verifier_state(curr_pos_1d) == MineSweeperGameScreenTileStateBorder ||
+            tile->tile_type == MineSweeperGameScreenTileMine) {
+            continue;
+        }
+
+        uint8_t mine_count = count_surrounding_mines(board, curr_pos_1d);
+
+        MineSweeperGameScreenTileType tile_type = (MineSweeperGameScreenTileType) mine_count+1;
+
+        if (tile->tile_type == tile_type) {
+            continue;
+        }
+
+        tile->tile_type = tile_type;
+
+        if (get_verifier_state(curr_pos_1d) == MineSweeperGameScreenTileStateCleared) {
+            push_tile_queue(edges, curr_pos_1d);
+        }
+    }
+}
+
+/**
+ * Called when the verifier is stuck with the ambiguous edges left in edges.
+ *
+ * Moves up to MINESWEEPER_VERIFIER_REPAIR_MINES of the unflagged mines next to those edges to
+ * uncleared tiles that do not touch any cleared tile, so no number the verifier has already
+ * used changes in a way it has not seen. Flags placed so far are still mines and cleared tiles
+ * are still safe, so verification can continue from the same state.
+ *
+ * Returns false if there is nothing to move or nowhere to move it to.
+ */
+static bool repair_stuck_board(
+        MineSweeperTile* board,
+        const uint8_t board_width,
+        const uint8_t board_height,
+        const Point* first_move,
+        MineSweeperTileQueue* edges,
+        MineSweeperRng* rng) {
+
+    furi_assert(board);
+    furi_assert(edges);
+    furi_assert(rng);
+
+    const int16_t* neighbor_offsets = generation_geometry.neighbor_offsets;
+
+    // Collect the hidden mines around the stuck edges
+    uint16_t source_count = 0;
+
+    for (uint16_t k = 0; k < edges->size; k++) {
+        const uint16_t curr_pos_1d = peek_tile_queue(edges, k);
+
+        for (uint8_t j = 0; j < 8; j++) {
+            const uint16_t pos_1d = curr_pos_1d + neighbor_offsets[j];
+
+            if (get_verifier_state(pos_1d) != MineSweeperGameScreenTileStateUncleared ||
+                board[pos_1d].tile_type != MineSweeperGameScreenTileMine) {
+                continue;
+            }
+
+            bool is_duplicate = false;
+            for (uint16_t k = 0; k < source_count && !is_duplicate; k++) {
+                is_duplicate = repair_sources[k] == pos_1d;
+            }
+
+            if (!is_duplicate) {
+                repair_sources[source_count++] = pos_1d;
+            }
+        }
+    }
+
+    // Collect unexplored interior tiles, a mine placed there is not seen by any cleared tile
+    uint16_t target_count = 0;
+
+    for (uint8_t x = 0; x < board_height; x++) {
+        for (uint8_t y = 0; y < board_width; y++) {
+            const uint16_t i = get_board_index(board_width, x, y);
+
+            if (get_verifier_state(i) != MineSweeperGameScreenTileStateUncleared ||
+                board[i].tile_type == MineSweeperGameScreenTileMine ||
+                is_reserved_position(x, y, board_width, board_height, first_move)) {
+                continue;
+            }
+
+            bool is_interior = true;
+
+            for (uint8_t j = 0; j < 8 && is_interior; j++) {
+                is_interior = get_verifier_state(i + neighbor_offsets[j]) != MineSweeperGameScreenTileStateCleared;
+            }
+
+            if (is_interior) {
+                repair_targets[target_count++] = i;
+            }
+        }
+    }
+
+    uint8_t moved = 0;
+
+    while (moved < MINESWEEPER_VERIFIER_REPAIR_MINES && source_count > 0 && target_count > 0) {
+        // Draw without replacement from both lists
+        uint16_t k = mine_sweeper_rng_range(rng, source_count);
+        const uint16_t source = repair_sources[k];
+        repair_sources[k] = repair_sources[--source_count];
+
+        k = mine_sweeper_rng_range(rng, target_count);
+        const uint16_t target = repair_targets[k];
+        repair_targets[k] = repair_targets[--target_count];
+
+        board[target].tile_type = MineSweeperGameScreenTileMine;
+
+        // None never matches a count, so the recount below always writes the real number
+        board[source].tile_type = MineSweeperGameScreenTileNone;
+
+        recount_surrounding_tiles(board, source, edges);
+        recount_surrounding_tiles(board, target, edges);
+
+        moved++;
+    }
+
+    return moved > 0;
+}
+
+/**
+ * Collects the uncleared neighbors of the tile at pos_1d into hidden and counts its flagged neighbors.
+ * Returns the number of uncleared neighbors.
+ */
+static uint8_t get_hidden_neighbors(
+        const uint16_t pos_1d,
+        uint16_t* hidden,
+        uint8_t* num_flagged) {
+
+    const int16_t* neighbor_offsets = generation_geometry.neighbor_offsets;
+
+    uint8_t num_hidden = 0;
+    *num_flagged = 0;
+
+    for (uint8_t j = 0; j < 8; j++) {
+        const uint16_t neighbor_1d = pos_1d + neighbor_offsets[j];
+
+        if (get_verifier_state(neighbor_1d) == MineSweeperGameScreenTileStateUncleared) {
+            hidden[num_hidden++] = neighbor_1d;
+        } else if (get_verifier_state(neighbor_1d) == MineSweeperGameScreenTileStateFlagged) {
+            (*num_flagged)++;
+        }
+    }
+
+    return num_hidden;
+}
+
+/**
+ * Called when no edge can be decided on its own.
+ *
+ * When every hidden neighbor of edge a is also a hidden neighbor of a cleared tile b, the tiles
+ * only b touches hold exactly the mines b still needs minus the ones a still needs. If that is
+ * none of them they are cleared, if it is all of them they are flagged. Only tiles up to two away
+ * from a can share a neighbor with it, so each edge is compared against 24 tiles at most.
+ *
+ * Returns true after the first deduction, with total_mines lowered by any flags placed.
+ */
+static bool apply_subset_rule(
+        MineSweeperTile* board,
+        const uint8_t board_width,
+        const uint8_t board_height,
+        MineSweeperTileQueue* edges,
+        uint16_t* total_mines) {
+
+    furi_assert(board);
+    furi_assert(edges);
+
+    uint16_t hidden_a[8], hidden_b[8];
+    uint8_t num_hidden_a = 0, num_hidden_b = 0;
+    int8_t extra_mines = 0;
+    bool is_found = false;
+
+    const uint16_t stride = MINESWEEPER_BOARD_STRIDE(board_width);
+
+    // Only look for a pair while iterating, clearing tiles pushes new edges on the ring
+    for (uint16_t k = 0; k < edges->size && !is_found; k++) {
+        const uint16_t a_1d = peek_tile_queue(edges, k);
+        const Point a = (Point){.x = a_1d / stride - 1, .y = a_1d % stride - 1};
+
+        uint8_t num_flagged_a = 0;
+        num_hidden_a = get_hidden_neighbors(a_1d, hidden_a, &num_flagged_a);
+
+        if (num_hidden_a == 0) {
+            continue;
+        }
+
+        const int8_t mines_a = (int8_t)(board[a_1d].tile_type - 1) - num_flagged_a;
+
+        for (int8_t i = -2; i <= 2 && !is_found; i++) {
+            for (int8_t j = -2; j <= 2 && !is_found; j++) {
+                const int16_t bx = a.x + i;
+                const int16_t by = a.y + j;
+
+                if ((i == 0 && j == 0) || bx < 0 || by < 0 || bx >= board_height || by >= board_width) {
+                    continue;
+                }
+
+                const uint16_t b_1d = get_board_index(board_width, bx, by);
+                const MineSweeperTile* tile_b = &board[b_1d];
+
+                if (get_verifier_state(b_1d) != MineSweeperGameScreenTileStateCleared ||
+                    tile_b->tile_type == MineSweeperGameScreenTileZero) {
+                    continue;
+                }
+
+                uint8_t num_flagged_b = 0;
+                num_hidden_b = get_hidden_neighbors(b_1d, hidden_b, &num_flagged_b);
+
+                if (num_hidden_b <= num_hidden_a) {
+                    continue;
+                }
+
+                // Every hidden neighbor of a has to be one of b's as well
+                uint8_t num_shared = 0;
+                for (uint8_t ka = 0; ka < num_hidden_a; ka++) {
+                    for (uint8_t kb = 0; kb < num_hidden_b; kb++) {
+                        num_shared += hidden_a[ka] == hidden_b[kb];
+                    }
+                }
+
+                if (num_shared != num_hidden_a) {
+                    continue;
+                }
+
+                extra_mines = ((int8_t)(tile_b->tile_type - 1) - num_flagged_b) - mines_a;
+                is_found = extra_mines == 0 || extra_mines == num_hidden_b - num_hidden_a;
+            }
+        }
+    }
+
+    if (!is_found) {
+        return false;
+    }
+
+    for (uint8_t kb = 0; kb < num_hidden_b; kb++) {
+        bool is_shared = false;
+        for (uint8_t ka = 0; ka < num_hidden_a && !is_shared; ka++) {
+            is_shared = hidden_a[ka] == hidden_b[kb];
+        }
+
+        if (is_shared) {
+            continue;
+        }
+
+        if (extra_mines == 0) {
+            bfs_tile_clear_verifier(
+                    board, board_width, board_height, hidden_b[kb] / stride - 1, hidden_b[kb] % stride - 1, edges);
+        } else {
+            set_verifier_state(hidden_b[kb], MineSweeperGameScreenTileStateFlagged);
+        }
+    }
+
+    *total_mines -= (extra_mines == 0) ? 0 : num_hidden_b - num_hidden_a;
+
+    return true;
+}
+
+/**
+ * This is a bfs_tile clear used by the verifier which performs the normal tile clear
+ * but also pushes new edges to the ring passed in. There is a separate function used
+ * for the bfs_tile_clear used on the user click
+ */
+static void bfs_tile_clear_verifier(
+        MineSweeperTile* board,
+        const uint8_t board_width,
+        const uint8_t board_height,
+        const uint16_t x,
+        const uint16_t y,
+        MineSweeperTileQueue* edges) {
+
+    furi_assert(board);
+    furi_assert(edges);
+    furi_assert(x < board_height && y < board_width);
+    
+    const int16_t* neighbor_offsets = generation_geometry.neighbor_offsets;
+
+    // Tiles are marked visited when they are queued, so no tile is queued twice
+    clear_visited_set(&generation_visited);
+    clear_tile_queue(&generation_queue);
+
+    const uint16_t start_pos_1d = get_board_index(board_width, x, y);
+    set_tile_visited(&generation_visited, start_pos_1d);
+    push_tile_queue(&generation_queue, start_pos_1d);
+    
+    while (generation_queue.size > 0) {
+
+        const uint16_t curr_pos_1d = pop_tile_queue(&generation_queue);
+        
+        // If it is cleared continue
+        if (get_verifier_state(curr_pos_1d) == MineSweeperGameScreenTileStateCleared) {
+            continue;
+        } 
+
+        // Else set tile to cleared
+        set_verifier_state(curr_pos_1d, MineSweeperGameScreenTileStateCleared);
+        
+
+        // When we hit a potential edge
+        if (board[curr_pos_1d].tile_type != MineSweeperGameScreenTileZero) {
+
+            // Add to our passed in ring of edges
+            push_tile_queue(edges, curr_pos_1d);
+
+            // Continue processing next point for bfs tile clear
+            continue;
+        }
+
+
+        // Process all surrounding neighbors and add valid to the queue,
+        // the border ring is never uncleared so it stops the search without bounds checks
+        for (uint8_t i = 0; i < 8; i++) {
+            const uint16_t neighbor_1d = curr_pos_1d + neighbor_offsets[i];
+
+            if (get_verifier_state(neighbor_1d) != MineSweeperGameScreenTileStateUncleared ||
+                is_tile_visited(&generation_visited, neighbor_1d)) {
+                continue;
+            }
+
+            set_tile_visited(&generation_visited, neighbor_1d);
+            push_tile_queue(&generation_queue, neighbor_1d);
+        }
+    }
+}
+
+/**
+ * Walks every zero region the same way bfs_tile_clear opens it. The visited set marks the regions
+ * and their numbered border, the queue holds the zero tiles of the region still to walk.
+ */
+static uint16_t walk_board_3bv(
+        const MineSweeperTile* board,
+        const MineSweeperBoardGeometry* geometry,
+        MineSweeperVisitedSet* visited,
+        MineSweeperTileQueue* queue) {
+
+    const uint8_t board_width = geometry->width;
+    const uint8_t board_height = geometry->height;
+    const int16_t* neighbor_offsets = geometry->neighbor_offsets;
+
+    uint16_t board_3bv = 0;
+
+    clear_visited_set(visited);
+    clear_tile_queue(queue);
+
+    // One click for each zero region, which also opens all of its numbered border
+    for (uint8_t x = 0; x < board_height; x++) {
+        for (uint8_t y = 0; y < board_width; y++) {
+            const uint16_t i = get_board_index(board_width, x, y);
+
+            if (board[i].tile_type != MineSweeperGameScreenTileZero || is_tile_visited(visited, i)) {
+                continue;
+            }
+
+            board_3bv++;
+
+            set_tile_visited(visited, i);
+            push_tile_queue(queue, i);
+
+            while (queue->size > 0) {
+                const uint16_t curr_pos_1d = pop_tile_queue(queue);
+
+                for (uint8_t j = 0; j < 8; j++) {
+                    const uint16_t pos_1d = curr_pos_1d + neighbor_offsets[j];
+
+                    if (is_tile_visited(visited, pos_1d)) {
+                        continue;
+                    }
+
+                    set_tile_visited(visited, pos_1d);
+
+                    // A zero never borders a mine, so its neighbors are either more of the region or its border,
+                    // the ring tiles are type None and only get marked
+                    if (board[pos_1d].tile_type == MineSweeperGameScreenTileZero) {
+                        push_tile_queue(queue, pos_1d);
+                    }
+                }
+            }
+        }
+    }
+
+    // One click for every numbered tile no zero region opens
+    for (uint8_t x = 0; x < board_height; x++) {
+        for (uint8_t y = 0; y < board_width; y++) {
+            const uint16_t i = get_board_index(board_width, x, y);
+
+            if (board[i].tile_type != MineSweeperGameScreenTileMine && !is_tile_visited(visited, i)) {
+                board_3bv++;
+            }
+        }
+    }
+
+    return board_3bv;
+}
+
+/**
+ * Runs on every generation attempt with a band, so it walks on the visited set and queue of the scratch
+ */
+uint16_t get_board_3bv(
+        const MineSweeperTile* board,
+        const uint8_t board_width,
+        const uint8_t board_height) {
+
+    furi_assert(board);
+    furi_assert(scratch_width == board_width && scratch_height == board_height);
+
+    claim_board_scratch();
+
+    set_board_geometry(&generation_geometry, board_width, board_height);
+
+    const uint16_t board_3bv = walk_board_3bv(board, &generation_geometry, &generation_visited, &generation_queue);
+
+    mine_sweeper_engine_stack_audit(MineSweeperStackAuditBoard3bv);
+
+    release_board_scratch();
+
+    return board_3bv;
+}
+
+uint16_t get_live_board_3bv(
+        const MineSweeperTile* board,
+        const MineSweeperBoardGeometry* geometry,
+        MineSweeperVisitedSet* visited,
+        MineSweeperTileQueue* queue) {
+
+    furi_assert(board);
+    furi_assert(geometry);
+    furi_assert(visited);
+    furi_assert(queue);
+
+    const uint16_t board_3bv = walk_board_3bv(board, geometry, visited, queue);
+
+    mine_sweeper_engine_stack_audit(MineSweeperStackAuditBoard3bv);
+
+    return board_3bv;
+}
+
+/**
+ * Clears the zero tiles queued by bfs_tile_clear or chord_tile_clear and floods out from them.
+ * Zero regions are cleared a horizontal span at a time, so only one tile of every run of zeros
+ * is queued and the tiles next to a span are read once per row instead of once per tile.
+ * The queue holds one zero tile of every run still to clear, which was marked visited when it was queued.
+ */
+static uint16_t flood_tile_spans(
+        MineSweeperTile* board,
+        const uint16_t stride,
+        MineSweeperVisitedSet* visited,
+        MineSweeperTileQueue* queue,
+        MineSweeperUnclearedIndex* uncleared) {
+
+    // We will return this number as the number of tiles cleared
+    uint16_t ret = 0;
+
+    while (queue->size > 0) {
+
+        const uint16_t seed_pos_1d = pop_tile_queue(queue);
+
+        // The whole run was already cleared from another tile of it
+        if (board[seed_pos_1d].tile_state != MineSweeperGameScreenTileStateUncleared) {
+            continue;
+        }
+
+        // Grow the span over the uncleared zeros left and right of the seed,
+        // the border ring is never uncleared so it stops the span without bounds checks
+        uint16_t first = seed_pos_1d;
+        uint16_t last = seed_pos_1d;
+
+        while (board[first - 1].tile_state == MineSweeperGameScreenTileStateUncleared &&
+               board[first - 1].tile_type == MineSweeperGameScreenTileZero) {
+            first--;
+        }
+
+        while (board[last + 1].tile_state == MineSweeperGameScreenTileStateUncleared &&
+               board[last + 1].tile_type == MineSweeperGameScreenTileZero) {
+            last++;
+        }
+
+        // Clear the span along with the tiles at both of its ends, which can only be numbers
+        for (uint16_t pos_1d = first - 1; pos_1d <= last + 1; pos_1d++) {
+            if (board[pos_1d].tile_state == MineSweeperGameScreenTileStateUncleared) {
+                board[pos_1d].tile_state = MineSweeperGameScreenTileStateCleared;
+                update_uncleared_index(uncleared, board, pos_1d);
+                ret++;
+            }
+        }
+
+        // Every tile of the rows above and below from first-1 to last+1 touches the span. Numbers there are
+        // cleared right away and every run of zeros is queued to be cleared as a span of its own
+        for (int8_t row = -1; row <= 1; row += 2) {
+            const uint16_t row_first = first - 1 + row * stride;
+            const uint16_t row_last = last + 1 + row * stride;
+            bool is_in_run = false;
+
+            for (uint16_t pos_1d = row_first; pos_1d <= row_last; pos_1d++) {
+                if (board[pos_1d].tile_state != MineSweeperGameScreenTileStateUncleared) {
+                    is_in_run = false;
+                    continue;
+                }
+
+                if (board[pos_1d].tile_type != MineSweeperGameScreenTileZero) {
+                    board[pos_1d].tile_state = MineSweeperGameScreenTileStateCleared;
+                    update_uncleared_index(uncleared, board, pos_1d);
+                    ret++;
+                    is_in_run = false;
+                    continue;
+                }
+
+                if (!is_in_run && !is_tile_visited(visited, pos_1d)) {
+                    set_tile_visited(visited, pos_1d);
+                    push_tile_queue(queue, pos_1d);
+                }
+
+                is_in_run = true;
+            }
+        }
+    }
+
+    return ret;
+}
+
+/**
+ * This is a bfs_tile clear used in the input callbacks to clear the board on user input.
+ */
+uint16_t bfs_tile_clear(
+        MineSweeperTile* board,
+        const MineSweeperBoardGeometry* geometry,
+        MineSweeperVisitedSet* visited,
+        MineSweeperTileQueue* queue,
+        MineSweeperUnclearedIndex* uncleared,
+        const uint16_t x,
+        const uint16_t y) {
+
+    furi_assert(board);
+    furi_assert(geometry);
+    furi_assert(visited);
+    furi_assert(queue);
+    furi_assert(uncleared);
+    furi_assert(x < geometry->height && y < geometry->width);
+
+    const uint8_t board_width = geometry->width;
+
+    const uint16_t start_pos_1d = get_board_index(board_width, x, y);
+
+    // Cleared and flagged tiles are left alone, a number is the only tile it clears
+    if (board[start_pos_1d].tile_state != MineSweeperGameScreenTileStateUncleared) {
+        return 0;
+    }
+
+    if (board[start_pos_1d].tile_type != MineSweeperGameScreenTileZero) {
+        board[start_pos_1d].tile_state = MineSweeperGameScreenTileStateCleared;
+        update_uncleared_index(uncleared, board, start_pos_1d);
+        refresh_frontier(uncleared, board, geometry);
+        return 1;
+    }
+
+    clear_visited_set(visited);
+    clear_tile_queue(queue);
+
+    set_tile_visited(visited, start_pos_1d);
+    push_tile_queue(queue, start_pos_1d);
+
+    const uint16_t ret = flood_tile_spans(board, MINESWEEPER_BOARD_STRIDE(board_width), visited, queue, uncleared);
+
+    refresh_frontier(uncleared, board, geometry);
+    mine_sweeper_engine_stack_audit(MineSweeperStackAuditTileClear);
+    
+    return ret;
+}
+
+/**
+ * All of the uncleared neighbors seed one flood, so regions reached from several of them
+ * are only cleared once and every tile is counted by the first seed that gets to it.
+ */
+uint16_t chord_tile_clear(
+        MineSweeperTile* board,
+        const MineSweeperBoardGeometry* geometry,
+        MineSweeperVisitedSet* visited,
+        MineSweeperTileQueue* queue,
+        MineSweeperUnclearedIndex* uncleared,
+        const uint16_t x,
+        const uint16_t y,
+        bool* is_mine_cleared) {
+
+    furi_assert(board);
+    furi_assert(geometry);
+    furi_assert(visited);
+    furi_assert(queue);
+    furi_assert(uncleared);
+    furi_assert(is_mine_cleared);
+    furi_assert(x < geometry->height && y < geometry->width);
+
+    const uint8_t board_width = geometry->width;
+    const uint16_t curr_pos_1d = get_board_index(board_width, x, y);
+
+    uint16_t ret = 0;
+    *is_mine_cleared = false;
+
+    clear_visited_set(visited);
+    clear_tile_queue(queue);
+
+    // Border tiles are never uncleared, so they need no bounds checks
+    for (uint8_t j = 0; j < 8; j++) {
+        const uint16_t pos_1d = curr_pos_1d + geometry->neighbor_offsets[j];
+        MineSweeperTile* tile = &board[pos_1d];
+
+        if (tile->tile_state != MineSweeperGameScreenTileStateUncleared) {
+            continue;
+        }
+
+        if (tile->tile_type == MineSweeperGameScreenTileMine) {
+            *is_mine_cleared = true;
+        }
+
+        if (tile->tile_type != MineSweeperGameScreenTileZero) {
+            tile->tile_state = MineSweeperGameScreenTileStateCleared;
+            update_uncleared_index(uncleared, board, pos_1d);
+            ret++;
+        } else if (!is_tile_visited(visited, pos_1d)) {
+            set_tile_visited(visited, pos_1d);
+            push_tile_queue(queue, pos_1d);
+        }
+    }
+
+    ret += flood_tile_spans(board, MINESWEEPER_BOARD_STRIDE(board_width), visited, queue, uncleared);
+
+    refresh_frontier(uncleared, board, geometry);
+    mine_sweeper_engine_stack_audit(MineSweeperStackAuditTileClear);
+
+    return ret;
+}
+
+uint16_t play_tile_clear(
+        MineSweeperTile* board,
+        const MineSweeperBoardGeometry* geometry,
+        MineSweeperVisitedSet* visited,
+        MineSweeperTileQueue* queue,
+        MineSweeperUnclearedIndex* uncleared,
+        const uint16_t x,
+        const uint16_t y) {
+
+#ifdef MINESWEEPER_ENGINE_BITBOARD
+    UNUSED(visited);
+    UNUSED(queue);
+    return bitboard_tile_clear(board, geometry, uncleared, x, y);
+#else
+    return bfs_tile_clear(board, geometry, visited, queue, uncleared, x, y);
+#endif
+}
+
+uint16_t play_chord_clear(
+        MineSweeperTile* board,
+        const MineSweeperBoardGeometry* geometry,
+        MineSweeperVisitedSet* visited,
+        MineSweeperTileQueue* queue,
+        MineSweeperUnclearedIndex* uncleared,
+        const uint16_t x,
+        const uint16_t y,
+        bool* is_mine_cleared) {
+
+#ifdef MINESWEEPER_ENGINE_BITBOARD
+    UNUSED(visited);
+    UNUSED(queue);
+    return bitboard_chord_clear(board, geometry, uncleared, x, y, is_mine_cleared);
+#else
+    return chord_tile_clear(board, geometry, visited, queue, uncleared, x, y, is_mine_cleared);
+#endif
+}
+
+bool is_board_won(
+        const MineSweeperUnclearedIndex* uncleared,
+        const uint16_t mines_left,
+        const uint16_t flags_left,
+        const uint16_t tiles_left) {
+
+#ifdef MINESWEEPER_ENGINE_BITBOARD
+    UNUSED(mines_left);
+    UNUSED(flags_left);
+    UNUSED(tiles_left);
+    return is_bitboard_solved(uncleared);
+#else
+    UNUSED(uncleared);
+    return mines_left == 0 && flags_left == 0 && tiles_left == 0;
+#endif
+}
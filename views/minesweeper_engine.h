@@ -0,0 +1,613 @@
+/**
+ * @file minesweeper_engine.h
+ * Board model and the board algorithms used by the game screen
+ *
+ * Nothing in here touches the view model, so these functions can be
+ * run on any thread against any board buffer.
+ */
+
+#ifndef MINESWEEPER_ENGINE_H
+#define MINESWEEPER_ENGINE_H
+
+#include <furi.h>
+
+#include "minesweeper_redux_icons.h"
+#include "minesweeper_game_screen_i.h"
+#include "../helpers/mine_sweeper_rng.h"
+
+// Largest board dimensions the settings allow
+#define MINESWEEPER_BOARD_MAX_WIDTH  146
+#define MINESWEEPER_BOARD_MAX_HEIGHT 64
+
+// MAX TILES ALLOWED
+#define MINESWEEPER_BOARD_MAX_TILES  (MINESWEEPER_BOARD_MAX_WIDTH * MINESWEEPER_BOARD_MAX_HEIGHT)
+
+// Boards are stored with a ring of border tiles around them, so every tile on the board has all
+// 8 neighbors in the buffer and neighbor loops need no bounds checks. A row takes width+2 tiles
+#define MINESWEEPER_BOARD_STRIDE(width) ((uint16_t)(width) + 2)
+#define MINESWEEPER_BOARD_STORAGE_SIZE(width, height) (MINESWEEPER_BOARD_STRIDE(width) * ((uint16_t)(height) + 2))
+
+
+// Stack of the board generator worker. Generation and the SD card pool run on it, which needs more than the app's stack.
+// The firmware allocates it from the heap every time a job starts
+#define MINESWEEPER_BOARD_GENERATOR_STACK_SIZE (6 * 1024)
+
+// Heap a board pool read or write takes while it runs: the File, the file object the storage service opens
+// for it with its sector buffer, and the path string
+#define MINESWEEPER_BOARD_POOL_HEAP_SIZE (2 * 1024)
+
+// Heap that has to stay free after board memory is allocated. The engine itself allocates nothing after that,
+// but the generator worker is started with its stack while the boards are allocated, and it reads and writes
+// the board pool. The worker logs the heap it leaves when it starts, which is the headroom on the device
+#define MINESWEEPER_BOARD_HEAP_RESERVE (MINESWEEPER_BOARD_GENERATOR_STACK_SIZE + MINESWEEPER_BOARD_POOL_HEAP_SIZE)
+
+// Bytes needed to store one bit per tile
+#define MINESWEEPER_BOARD_MINE_BITS_SIZE(width, height) ((((uint16_t)(width) * (height)) + 7) / 8)
+
+// Add MINESWEEPER_ENGINE_BITBOARD to cdefines in application.fam to play on the bit plane engine in minesweeper_bitboard.h.
+// setup_board then numbers boards from a plane of mines, and play_tile_clear, play_chord_clear and is_board_won
+// work on bit planes kept in the uncleared index instead of walking the tile array
+
+// Add MINESWEEPER_STACK_AUDIT to cdefines in application.fam to log the stack the calling thread has never
+// touched whenever an engine entry point reaches a new low. Frame sizes per function come from building
+// with -fstack-usage, which writes a .su file next to every object file. Only the firmware build gives
+// numbers for the device, a host build in tests/host gives x86-64 frames
+
+// How many times the verifier may move mines away from a stuck frontier, and how many per repair
+#define MINESWEEPER_VERIFIER_MAX_REPAIRS 24
+#define MINESWEEPER_VERIFIER_REPAIR_MINES 2
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// They way this enum is set up allows us to index the tile_icons array for some mine types
+typedef enum {
+    MineSweeperGameScreenTileNone = 0,
+    MineSweeperGameScreenTileZero,
+    MineSweeperGameScreenTileOne,
+    MineSweeperGameScreenTileTwo,
+    MineSweeperGameScreenTileThree,
+    MineSweeperGameScreenTileFour,
+    MineSweeperGameScreenTileFive,
+    MineSweeperGameScreenTileSix,
+    MineSweeperGameScreenTileSeven,
+    MineSweeperGameScreenTileEight,
+    MineSweeperGameScreenTileMine,
+    MineSweeperGameScreenTileTypeCount,
+} MineSweeperGameScreenTileType;
+
+typedef enum {
+    MineSweeperGameScreenTileStateFlagged,
+    MineSweeperGameScreenTileStateUncleared,
+    MineSweeperGameScreenTileStateCleared,
+    MineSweeperGameScreenTileStateBorder,   // Tile in the ring around the board, never part of the game
+} MineSweeperGameScreenTileState;
+
+// One byte per tile, the icon to draw is looked up in tile_icons with the tile type
+typedef struct {
+    uint8_t tile_type : 4;      // MineSweeperGameScreenTileType
+    uint8_t tile_state : 2;     // MineSweeperGameScreenTileState
+} MineSweeperTile;
+
+// Deductions the verifier can make, in the order it tries them
+typedef enum {
+    MineSweeperVerifierRuleNone,    // Nothing beyond the first clear was needed
+    MineSweeperVerifierRuleSingle,  // A numbered tile decides all of its hidden neighbors on its own
+    MineSweeperVerifierRuleSubset,  // The hidden neighbors of one numbered tile are a subset of another's
+    MineSweeperVerifierRuleCount,
+} MineSweeperVerifierRule;
+
+// How much deduction the verifier needed to solve a board
+typedef struct {
+    uint16_t passes;                // Sweeps over the frontier
+    uint16_t largest_frontier;      // Most numbered tiles waiting to be decided in one sweep
+    uint8_t deepest_rule;           // MineSweeperVerifierRule
+    uint8_t repairs;                // Times mines were moved away from a stuck frontier
+} MineSweeperBoardDifficulty;
+
+// Indexed with MineSweeperGameScreenTileType, followed by the flag and uncleared icons
+extern const Icon* const tile_icons[13];
+
+// Offsets array used consistently when checking surrounding tiles
+static const int8_t offsets[8][2] = {
+    {-1,1},
+    {0,1},
+    {1,1},
+    {1,0},
+    {1,-1},
+    {0,-1},
+    {-1,-1},
+    {-1,0},
+};
+
+// Index offsets of the 8 neighbors of a tile for one board size, in the same order as offsets.
+// With the border ring every tile of a board has the same neighbor offsets, so one table covers all of them
+typedef struct {
+    uint8_t width;
+    uint8_t height;
+    int16_t neighbor_offsets[8];
+} MineSweeperBoardGeometry;
+
+/** Get the buffer index of the board tile at x,y
+ *
+ * x is the row and y the column, like everywhere else on the board.
+ */
+static inline uint16_t get_board_index(const uint8_t board_width, const uint16_t x, const uint16_t y) {
+    return (x + 1) * MINESWEEPER_BOARD_STRIDE(board_width) + (y + 1);
+}
+
+// Tiles reached by one search, one bit per buffer index. A word of bits only counts while its generation
+// matches the set's, so a new search starts by moving the set to the next generation instead of clearing it
+typedef struct {
+    uint32_t* words;
+    uint8_t* generations;
+    uint16_t num_words;
+    uint8_t generation;
+} MineSweeperVisitedSet;
+
+static inline bool is_tile_visited(const MineSweeperVisitedSet* visited, const uint16_t pos_1d) {
+    const uint16_t word = pos_1d >> 5;
+    return visited->generations[word] == visited->generation && ((visited->words[word] >> (pos_1d & 31)) & 1);
+}
+
+static inline void set_tile_visited(MineSweeperVisitedSet* visited, const uint16_t pos_1d) {
+    const uint16_t word = pos_1d >> 5;
+
+    if (visited->generations[word] != visited->generation) {
+        visited->generations[word] = visited->generation;
+        visited->words[word] = 0;
+    }
+
+    visited->words[word] |= (uint32_t)1 << (pos_1d & 31);
+}
+
+// Buffer indices of the tiles a flood still has to look at, in a ring sized to the number of board tiles.
+// Floods mark a tile visited before queuing it, so a tile is queued once at most and the ring never fills.
+// The verifier keeps its edges in one as well, with room on top for the tiles its repairs queue again
+typedef struct {
+    uint16_t* indices;
+    uint16_t capacity;
+    uint16_t head;
+    uint16_t size;
+} MineSweeperTileQueue;
+
+static inline void clear_tile_queue(MineSweeperTileQueue* queue) {
+    queue->head = 0;
+    queue->size = 0;
+}
+
+static inline void push_tile_queue(MineSweeperTileQueue* queue, const uint16_t pos_1d) {
+    furi_assert(queue->size < queue->capacity);
+
+    uint16_t tail = queue->head + queue->size;
+    if (tail >= queue->capacity) tail -= queue->capacity;
+
+    queue->indices[tail] = pos_1d;
+    queue->size++;
+}
+
+// Get the tile i places behind the head without taking it off the queue
+static inline uint16_t peek_tile_queue(const MineSweeperTileQueue* queue, const uint16_t i) {
+    furi_assert(i < queue->size);
+
+    uint16_t pos = queue->head + i;
+    if (pos >= queue->capacity) pos -= queue->capacity;
+
+    return queue->indices[pos];
+}
+
+static inline uint16_t pop_tile_queue(MineSweeperTileQueue* queue) {
+    furi_assert(queue->size > 0);
+
+    const uint16_t pos_1d = queue->indices[queue->head];
+    if (++queue->head == queue->capacity) queue->head = 0;
+
+    queue->size--;
+    return pos_1d;
+}
+
+// Uncleared tiles of a board, one bit per tile in rows of words and a count for every row, along with
+// the frontier, the cleared numbered tiles that still touch a tile that is not revealed.
+// Flagged tiles are not revealed, so they keep their numbers on the frontier and placing or removing
+// a flag never changes it. Only clearing a tile does.
+// Everything that moves a tile from or to uncleared updates the rows, so the closest uncleared tile is found
+// from the rows around a tile. Cleared tiles also grow the changed rows, and refresh_frontier looks at
+// the frontier in those rows once after a flood instead of at the neighbors of every tile it clears
+typedef struct {
+    uint32_t* rows;         // row_words words for every row, bit y of a row is the tile in column y
+    uint8_t* row_counts;    // Uncleared tiles in every row
+    uint32_t* frontier;     // One bit per buffer index, set for the tiles of the frontier
+    uint16_t count;         // Uncleared tiles on the board
+    uint16_t frontier_count;
+    uint8_t row_words;
+    uint8_t board_width;
+    uint8_t board_height;
+    uint8_t changed_top;    // Rows of the tiles cleared since the last refresh_frontier,
+    uint8_t changed_bottom; // none while changed_top is below changed_bottom
+#ifdef MINESWEEPER_ENGINE_BITBOARD
+    uint32_t* mines;        // Planes of the bit plane engine in rows like rows, the mines, the zeros
+    uint32_t* zeros;        // and the flagged tiles, kept up to date with the tile states
+    uint32_t* flags;
+    uint32_t* pending;      // Zeros a bit plane flood has cleared but not opened the neighbors of yet
+    uint16_t mine_count;
+#endif
+} MineSweeperUnclearedIndex;
+
+static inline bool is_frontier_tile(const MineSweeperUnclearedIndex* uncleared, const uint16_t pos_1d) {
+    return (uncleared->frontier[pos_1d >> 5] >> (pos_1d & 31)) & 1;
+}
+
+/** Set up the neighbor table of a board size
+ *
+ * Only rebuilds the table when the size differs from the one it holds, so it can be called
+ * before every use and costs nothing until the board size changes.
+ *
+ * @param       geometry    MineSweeperBoardGeometry* to set up
+ * @return      bool true if the table was rebuilt
+ */
+bool set_board_geometry(MineSweeperBoardGeometry* geometry, const uint8_t board_width, const uint8_t board_height);
+
+/** Set every tile of a board to an uncleared tile of one type and put the border ring around it
+ *
+ * @param       board       MineSweeperTile* buffer of at least MINESWEEPER_BOARD_STORAGE_SIZE tiles
+ * @param       tile_type   MineSweeperGameScreenTileType every tile gets
+ */
+void clear_board(
+        MineSweeperTile* board,
+        const uint8_t board_width,
+        const uint8_t board_height,
+        const MineSweeperGameScreenTileType tile_type);
+
+/** Resize a board buffer to exactly the storage of a board size
+ *
+ * The old buffer is freed first. The new one is only allocated if it fits in the free heap
+ * with MINESWEEPER_BOARD_HEAP_RESERVE to spare, otherwise board is left NULL.
+ * Nothing is done if the buffer already has the right size.
+ *
+ * @param       board       MineSweeperTile** buffer to resize, can point to NULL
+ * @param       board_size  uint16_t* number of tiles in the buffer, updated with it
+ * @return      bool true if board holds a buffer for the board size
+ */
+bool resize_board(MineSweeperTile** board, uint16_t* board_size, const uint8_t board_width, const uint8_t board_height);
+
+/** Free a board buffer allocated by resize_board
+ *
+ * @param       board       MineSweeperTile** buffer to free, set to NULL
+ * @param       board_size  uint16_t* number of tiles in the buffer, set to 0
+ */
+void free_board(MineSweeperTile** board, uint16_t* board_size);
+
+/** Allocate a visited set for a board size
+ *
+ * Does nothing if the set is already sized for this board. Checked against the free heap like resize_board.
+ *
+ * @param       visited     MineSweeperVisitedSet* to size
+ * @return      bool true if the set fits this board size
+ */
+bool resize_visited_set(MineSweeperVisitedSet* visited, const uint8_t board_width, const uint8_t board_height);
+
+/** Free a visited set allocated by resize_visited_set */
+void free_visited_set(MineSweeperVisitedSet* visited);
+
+/** Mark every tile of a visited set as not visited
+ *
+ * Moves the set to its next generation, the words are only cleared once every 255 calls.
+ */
+void clear_visited_set(MineSweeperVisitedSet* visited);
+
+/** Allocate a tile queue for a board size
+ *
+ * Does nothing if the queue is already sized for this board. Checked against the free heap like resize_board.
+ *
+ * @param       queue       MineSweeperTileQueue* to size
+ * @return      bool true if the queue fits this board size
+ */
+bool resize_tile_queue(MineSweeperTileQueue* queue, const uint8_t board_width, const uint8_t board_height);
+
+/** Free a tile queue allocated by resize_tile_queue */
+void free_tile_queue(MineSweeperTileQueue* queue);
+
+/** Allocate an uncleared index for a board size
+ *
+ * Does nothing if the index is already sized for this board. Checked against the free heap like resize_board.
+ *
+ * @param       uncleared   MineSweeperUnclearedIndex* to size
+ * @return      bool true if the index fits this board size
+ */
+bool resize_uncleared_index(MineSweeperUnclearedIndex* uncleared, const uint8_t board_width, const uint8_t board_height);
+
+/** Free an uncleared index allocated by resize_uncleared_index */
+void free_uncleared_index(MineSweeperUnclearedIndex* uncleared);
+
+/** Build an uncleared index and its frontier from the tile states of a board
+ *
+ * Run whenever a whole board comes in, single tiles are kept up to date with update_uncleared_index.
+ *
+ * @param       uncleared   MineSweeperUnclearedIndex* sized for board
+ * @param       geometry    const MineSweeperBoardGeometry* set up for the size of board
+ */
+void reset_uncleared_index(
+        MineSweeperUnclearedIndex* uncleared,
+        const MineSweeperTile* board,
+        const MineSweeperBoardGeometry* geometry);
+
+/** Record the new state of one tile in an uncleared index
+ *
+ * Called after the tile state on the board has changed. A cleared number is put on the frontier
+ * without looking at its neighbors, the frontier is exact again after the next refresh_frontier.
+ *
+ * @param       uncleared   MineSweeperUnclearedIndex* sized for board
+ * @param       board       const MineSweeperTile* board the tile is on
+ * @param       pos_1d      uint16_t buffer index of the tile
+ */
+void update_uncleared_index(
+        MineSweeperUnclearedIndex* uncleared,
+        const MineSweeperTile* board,
+        const uint16_t pos_1d);
+
+/** Bring the frontier up to date with the tiles cleared since the last refresh
+ *
+ * Only frontier tiles in the changed rows and the rows next to them are looked at, a cleared tile
+ * can only take the numbers next to it off. The floods of the engine call it once when they are done,
+ * anything else that clears a tile calls it itself.
+ *
+ * @param       uncleared   MineSweeperUnclearedIndex* sized for board
+ * @param       board       const MineSweeperTile* board the tiles were cleared on
+ * @param       geometry    const MineSweeperBoardGeometry* set up for the size of board
+ */
+void refresh_frontier(
+        MineSweeperUnclearedIndex* uncleared,
+        const MineSweeperTile* board,
+        const MineSweeperBoardGeometry* geometry);
+
+/** Get the first frontier tile at or after a buffer index
+ *
+ * Walks the frontier bits, so the whole frontier is visited with
+ * for (pos_1d = get_next_frontier_tile(uncleared, 0); pos_1d != 0; pos_1d = get_next_frontier_tile(uncleared, pos_1d + 1))
+ *
+ * @param       uncleared   const MineSweeperUnclearedIndex* of the board
+ * @param       pos_1d      uint16_t buffer index to start at
+ * @return      uint16_t buffer index of the tile, 0 if there is none as that is a border tile
+ */
+uint16_t get_next_frontier_tile(const MineSweeperUnclearedIndex* uncleared, const uint16_t pos_1d);
+
+/** Find the uncleared tile closest to the tile at x,y
+ *
+ * Rows are looked at in rings around x and stop as soon as no farther row can be closer,
+ * distances are compared squared. Ties go to the row above and then to the column on the left.
+ *
+ * @param       uncleared   const MineSweeperUnclearedIndex* of the board
+ * @param       closest     Point* set to the closest uncleared tile, only written if there is one
+ * @return      bool true if the board has an uncleared tile
+ */
+bool find_closest_uncleared_tile(
+        const MineSweeperUnclearedIndex* uncleared,
+        const uint16_t x,
+        const uint16_t y,
+        Point* closest);
+
+/** Size the engine scratch memory for a board size
+ *
+ * setup_board, the verifier and get_board_3bv work in scratch memory sized for one board size.
+ * It is checked against the free heap like resize_board and has to be reserved for a board size
+ * before any of them are called for it. Must not be called while a board is being generated.
+ *
+ * The scratch belongs to the board generator, only its worker runs setup_board, the verifier
+ * and get_board_3bv. Each of them claims the scratch for its thread and furi_check fails if
+ * another thread is still using it.
+ *
+ * @return      bool true if the scratch memory fits this board size
+ */
+bool reserve_board_scratch(const uint8_t board_width, const uint8_t board_height);
+
+/** Free the engine scratch memory */
+void free_board_scratch(void);
+
+/** Check whether a board size fits in the heap
+ *
+ * Counts two board buffers, one for the game and one for the generator, the visited set and tile
+ * queue of the game and the engine scratch memory. Board memory that is already allocated is counted as free since it is replaced.
+ *
+ * @return      bool true if all board memory for this size can be allocated
+ */
+bool is_board_in_memory_budget(const uint8_t board_width, const uint8_t board_height);
+
+/** Get the number of mines setup_board places for these settings
+ *
+ * @return      uint16_t number of mines
+ */
+uint16_t get_board_mine_count(const uint8_t board_width, const uint8_t board_height, const uint8_t board_difficulty);
+
+/** Fill a board with a random layout
+ *
+ * Every tile is left uncleared. All randomness is drawn from rng.
+ *
+ * @param       board       MineSweeperTile* buffer of at least MINESWEEPER_BOARD_STORAGE_SIZE tiles
+ * @param       width       uint8_t width for board
+ * @param       height      uint8_t height for board
+ * @param       difficulty  uint8_t difficulty for board
+ * @param       first_move  const Point* tile that is opened first and is kept in a zero region,
+ *                          NULL keeps the corners free instead
+ * @param       rng         MineSweeperRng* generator to draw from
+ *
+ * @return      uint16_t number of mines placed
+ */
+uint16_t setup_board(
+        MineSweeperTile* board,
+        const uint8_t board_width,
+        const uint8_t board_height,
+        const uint8_t board_difficulty,
+        const Point* first_move,
+        MineSweeperRng* rng);
+
+/** Store the mine layout of a board as one bit per tile
+ *
+ * @param       mine_bits   uint8_t* buffer of MINESWEEPER_BOARD_MINE_BITS_SIZE bytes
+ */
+void pack_board_mines(
+        const MineSweeperTile* board,
+        const uint8_t board_width,
+        const uint8_t board_height,
+        uint8_t* mine_bits);
+
+/** Rebuild a board from a layout stored by pack_board_mines
+ *
+ * Numbers are recounted and every tile is left uncleared, like setup_board does.
+ * Does not use the engine scratch, so it can run on the GUI thread.
+ *
+ * @return      uint16_t number of mines in the layout
+ */
+uint16_t unpack_board_mines(
+        MineSweeperTile* board,
+        const uint8_t board_width,
+        const uint8_t board_height,
+        const uint8_t* mine_bits);
+
+/** Check whether a board can be solved from its first move without guessing
+ *
+ * When the verifier gets stuck and rng is set, a few mines next to the stuck frontier
+ * are moved to unexplored tiles and verification resumes, up to MINESWEEPER_VERIFIER_MAX_REPAIRS
+ * times. Repairs change the tile types of board, the mine count stays the same.
+ *
+ * The verifier keeps its own tile states in the engine scratch memory, the tile states of board
+ * are not read or changed.
+ *
+ * @param       first_move  const Point* the board was set up around, NULL starts from 0,0
+ * @param       rng         MineSweeperRng* to draw repairs from, NULL to only verify
+ * @param       difficulty  MineSweeperBoardDifficulty* set to the deduction that was needed, can be NULL.
+ *                          After repairs it describes the path taken, not a fresh solve of the final board
+ *
+ * @return      true if it is unambiguously solvable
+ */
+bool check_board_with_verifier(
+        MineSweeperTile* board,
+        const uint8_t board_width,
+        const uint8_t board_height,
+        uint16_t total_mines,
+        const Point* first_move,
+        MineSweeperRng* rng,
+        MineSweeperBoardDifficulty* difficulty);
+
+/** Get the 3BV of a board, the least number of clicks that clears it without flagging
+ *
+ * Every zero region takes one click and opens its numbered border with it,
+ * every numbered tile that does not border a zero region takes one click of its own.
+ * Only the tile types are read, so it can be run at any point of a game.
+ * Walks in the engine scratch, so it is for the generator worker, see get_live_board_3bv.
+ *
+ * @return      uint16_t 3BV of the board
+ */
+uint16_t get_board_3bv(
+        const MineSweeperTile* board,
+        const uint8_t board_width,
+        const uint8_t board_height);
+
+/** Get the 3BV of a board like get_board_3bv, on the memory of the caller instead of the engine scratch
+ *
+ * Used by the game screen, which counts the 3BV of a board on the GUI thread when it is installed.
+ *
+ * @param       geometry    const MineSweeperBoardGeometry* set up for the size of board
+ * @param       visited     MineSweeperVisitedSet* sized for board, cleared by the walk
+ * @param       queue       MineSweeperTileQueue* sized for board, cleared by the walk
+ * @return      uint16_t 3BV of the board
+ */
+uint16_t get_live_board_3bv(
+        const MineSweeperTile* board,
+        const MineSweeperBoardGeometry* geometry,
+        MineSweeperVisitedSet* visited,
+        MineSweeperTileQueue* queue);
+
+/** Clear the tile at x,y and flood out through zero tiles
+ *
+ * @param       geometry    const MineSweeperBoardGeometry* set up for the size of board
+ * @param       visited     MineSweeperVisitedSet* sized for board, cleared by the search
+ * @param       queue       MineSweeperTileQueue* sized for board, cleared by the search
+ * @param       uncleared   MineSweeperUnclearedIndex* of board, updated with every cleared tile
+ * @return      uint16_t number of tiles cleared
+ */
+uint16_t bfs_tile_clear(
+        MineSweeperTile* board,
+        const MineSweeperBoardGeometry* geometry,
+        MineSweeperVisitedSet* visited,
+        MineSweeperTileQueue* queue,
+        MineSweeperUnclearedIndex* uncleared,
+        const uint16_t x,
+        const uint16_t y);
+
+/** Clear every uncleared neighbor of the tile at x,y in one flood, the way a chord does
+ *
+ * Gives the same board as calling bfs_tile_clear on each neighbor in turn,
+ * but the neighbors share one search so overlapping regions are only walked once.
+ * Mines among the neighbors are cleared like any other tile and reported through is_mine_cleared.
+ *
+ * @param       geometry        const MineSweeperBoardGeometry* set up for the size of board
+ * @param       visited         MineSweeperVisitedSet* sized for board, cleared by the search
+ * @param       queue           MineSweeperTileQueue* sized for board, cleared by the search
+ * @param       uncleared       MineSweeperUnclearedIndex* of board, updated with every cleared tile
+ * @param       is_mine_cleared bool* set to true if one of the cleared tiles is a mine
+ * @return      uint16_t number of tiles cleared
+ */
+uint16_t chord_tile_clear(
+        MineSweeperTile* board,
+        const MineSweeperBoardGeometry* geometry,
+        MineSweeperVisitedSet* visited,
+        MineSweeperTileQueue* queue,
+        MineSweeperUnclearedIndex* uncleared,
+        const uint16_t x,
+        const uint16_t y,
+        bool* is_mine_cleared);
+
+/**
+ * The game plays through these three, they are the one place the engine is chosen.
+ * With MINESWEEPER_ENGINE_BITBOARD they run on the bit planes of the uncleared index,
+ * otherwise on bfs_tile_clear, chord_tile_clear and the counters of the game
+ *
+ * @param       board           MineSweeperTile* board of game
+ * @param       geometry        const MineSweeperBoardGeometry* of board
+ * @param       visited         MineSweeperVisitedSet* sized for board, unused on the bit planes
+ * @param       queue           MineSweeperTileQueue* sized for board, unused on the bit planes
+ * @param       uncleared       MineSweeperUnclearedIndex* of board, updated with every cleared tile
+ * @param       x               const uint16_t x coordinate of tile
+ * @param       y               const uint16_t y coordinate of tile
+ * @return      uint16_t number of tiles cleared
+ */
+uint16_t play_tile_clear(
+        MineSweeperTile* board,
+        const MineSweeperBoardGeometry* geometry,
+        MineSweeperVisitedSet* visited,
+        MineSweeperTileQueue* queue,
+        MineSweeperUnclearedIndex* uncleared,
+        const uint16_t x,
+        const uint16_t y);
+
+uint16_t play_chord_clear(
+        MineSweeperTile* board,
+        const MineSweeperBoardGeometry* geometry,
+        MineSweeperVisitedSet* visited,
+        MineSweeperTileQueue* queue,
+        MineSweeperUnclearedIndex* uncleared,
+        const uint16_t x,
+        const uint16_t y,
+        bool* is_mine_cleared);
+
+/**
+ * The counters are kept in both builds for the info bar, the bit planes count a win without them
+ *
+ * @param       uncleared       const MineSweeperUnclearedIndex* of board
+ * @param       mines_left      const uint16_t mines not yet flagged
+ * @param       flags_left      const uint16_t flags not yet placed
+ * @param       tiles_left      const uint16_t safe tiles not yet cleared
+ * @return      bool true when the game is won
+ */
+bool is_board_won(
+        const MineSweeperUnclearedIndex* uncleared,
+        const uint16_t mines_left,
+        const uint16_t flags_left,
+        const uint16_t tiles_left);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -1,47 +1,19 @@
 #include "minesweeper_game_screen.h"
 
-static const Icon* tile_icons[13] = {
-    &I_tile_empty_8x8,
-    &I_tile_0_8x8,
-    &I_tile_1_8x8,
-    &I_tile_2_8x8,
-    &I_tile_3_8x8,
-    &I_tile_4_8x8,
-    &I_tile_5_8x8,
-    &I_tile_6_8x8,
-    &I_tile_7_8x8,
-    &I_tile_8_8x8,
-    &I_tile_mine_8x8,
-    &I_tile_flag_8x8,
-    &I_tile_uncleared_8x8,
-};
-
-// They way this enum is set up allows us to index the Icon* array above for some mine types
-typedef enum {
-    MineSweeperGameScreenTileNone = 0,
-    MineSweeperGameScreenTileZero,
-    MineSweeperGameScreenTileOne,
-    MineSweeperGameScreenTileTwo,
-    MineSweeperGameScreenTileThree,
-    MineSweeperGameScreenTileFour,
-    MineSweeperGameScreenTileFive,
-    MineSweeperGameScreenTileSix,
-    MineSweeperGameScreenTileSeven,
-    MineSweeperGameScreenTileEight,
-    MineSweeperGameScreenTileMine,
-    MineSweeperGameScreenTileTypeCount,
-} MineSweeperGameScreenTileType;
-
-typedef enum {
-    MineSweeperGameScreenTileStateFlagged,
-    MineSweeperGameScreenTileStateUncleared,
-    MineSweeperGameScreenTileStateCleared,
-} MineSweeperGameScreenTileState;
-
 struct MineSweeperGameScreen {
     View* view;
     void* context;
     GameScreenInputCallback input_callback;
+    GameScreenWaitCallback wait_callback;
+    MineSweeperRng rng;
+    MineSweeperBoardGenerator* generator;
+    bool is_first_move_enabled;
+    MineSweeper3bvBand band_3bv;
+    MineSweeperLogicBand band_logic;
+    bool is_refill_pending;                 // The SD card pool for refill_config waits for the game to end or idle time
+    bool is_idle_refill_running;            // The refill was started by idle time and stops on the next key press
+    uint32_t last_input_tick;
+    MineSweeperBoardConfig refill_config;
 };
 
 typedef struct {
@@ -49,53 +21,49 @@ typedef struct {
 } CurrentPosition;
 
 typedef struct {
-    uint16_t x_abs, y_abs;
-    const Icon* icon;
-} IconElement;
-
-typedef struct {
-    IconElement icon_element;
-    MineSweeperGameScreenTileState tile_state;
-    MineSweeperGameScreenTileType tile_type;
-} MineSweeperTile;
-
-typedef struct {
-    MineSweeperTile board[ MINESWEEPER_BOARD_MAX_TILES ];
+    MineSweeperTile* board;
+    uint16_t board_size;                // Tiles in board, which is sized for its board and not the largest one
+    MineSweeperBoardGeometry geometry;  // Neighbor table of the board, rebuilt when its size changes
+    MineSweeperVisitedSet visited;      // Tiles reached by the current flood over board
+    MineSweeperTileQueue queue;         // Tiles the current flood over board still has to look at
+    MineSweeperUnclearedIndex uncleared; // Uncleared tiles and frontier of board, updated with every tile state change
     CurrentPosition curr_pos;
     uint8_t right_boundary, bottom_boundary,
             board_width, board_height, board_difficulty;
     uint16_t mines_left;
     uint16_t flags_left;
     uint16_t tiles_left;
+    uint16_t board_3bv;
     uint32_t start_tick;
+    uint64_t board_seed;
     FuriString* info_str;
     bool ensure_solvable_board;
     bool is_restart_triggered;
     bool is_holding_down_button;
     bool has_lost_game;
+    bool is_board_pending;      // No mines are placed until the first OK press
     uint8_t wrap_enable;
 } MineSweeperGameScreenModel;
 
-// Multipliers for ratio of mines to tiles
-static const float difficulty_multiplier[3] = {
-    0.15f,
-    0.17f,
-    0.19f,
+// Median 3BV of random boards per 1000 tiles for each difficulty, which hardly changes with the board size.
+// Measured over 2000 boards each from 16x7 up to 146x64, the 3BV bands split at it
+static const uint16_t median_3bv_per_mille[3] = {
+    230,
+    282,
+    326,
 };
 
-// Offsets array used consistently when checking surrounding tiles
-static const int8_t offsets[8][2] = {
-    {-1,1},
-    {0,1},
-    {1,1},
-    {1,0},
-    {1,-1},
-    {0,-1},
-    {-1,-1},
-    {-1,0},
+// Budget for any job the player may end up waiting on
+static const MineSweeperBoardBudget generation_budget = {
+    .max_attempts = MINESWEEPER_GENERATION_MAX_ATTEMPTS,
+    .max_ms = MINESWEEPER_GENERATION_MAX_MS,
 };
 
-static MineSweeperTile board_t[MINESWEEPER_BOARD_MAX_TILES];
+// Budget for a banded board the GUI thread waits on without a progress screen
+static const MineSweeperBoardBudget blocking_generation_budget = {
+    .max_attempts = MINESWEEPER_GENERATION_MAX_ATTEMPTS,
+    .max_ms = MINESWEEPER_GENERATION_BLOCKING_MS,
+};
 
 /****************************************************************
  * Function declarations
@@ -105,41 +73,45 @@ static MineSweeperTile board_t[MINESWEEPER_BOARD_MAX_TILES];
 
 // Static helper functions
 
-static void setup_board(MineSweeperGameScreen* instance);
-
-static bool check_board_with_verifier(
-        MineSweeperTile* board,
-        const uint8_t board_width,
-        const uint8_t board_height,
-        uint16_t total_mines);
-
-static void bfs_tile_clear_verifier(
-        MineSweeperTile* board,
-        const uint8_t board_width,
-        const uint8_t board_height,
-        const uint16_t x,
-        const uint16_t y,
-        point_deq_t* edges,
-        point_set_t* visited);
-
-static uint16_t bfs_tile_clear(MineSweeperTile* board,
-        const uint8_t board_width,
-        const uint8_t board_height,
-        const uint16_t x,
-        const uint16_t y);
+static MineSweeperBoardConfig mine_sweeper_game_screen_make_board_config(
+        MineSweeperGameScreen* instance,
+        uint8_t width,
+        uint8_t height,
+        uint8_t difficulty,
+        bool is_solvable);
 
 static void mine_sweeper_game_screen_set_board_information(
+        MineSweeperGameScreenModel* model,
+        const MineSweeperBoardConfig* config);
+
+static bool mine_sweeper_game_screen_install_board(MineSweeperGameScreen* instance);
+
+static void mine_sweeper_game_screen_start_pending_refill(MineSweeperGameScreen* instance);
+
+static void mine_sweeper_game_screen_stop_idle_refill(MineSweeperGameScreen* instance);
+
+static void mine_sweeper_game_screen_generate_board(
         MineSweeperGameScreen* instance,
-        const uint8_t width,
-        const uint8_t height,
-        const uint8_t difficulty,
-        bool is_solvable);
+        const MineSweeperBoardConfig* config,
+        uint64_t seed);
+
+static void mine_sweeper_game_screen_start_budgeted_job(
+        MineSweeperGameScreen* instance,
+        const MineSweeperBoardConfig* config);
+
+static void mine_sweeper_game_screen_reset_pending(
+        MineSweeperGameScreen* instance,
+        const MineSweeperBoardConfig* config);
+
+static void mine_sweeper_game_screen_generate_first_move(
+        MineSweeperGameScreen* instance,
+        MineSweeperGameScreenModel* model);
 
 static bool try_clear_surrounding_tiles(MineSweeperGameScreenModel* model);
 
-static void bfs_to_closest_tile(MineSweeperGameScreen* instance, MineSweeperGameScreenModel* model);
+static void move_to_closest_uncleared_tile(MineSweeperGameScreen* instance, MineSweeperGameScreenModel* model);
 
-// Currently not using enter/exit callback
+// Enter is not used, exit starts the SD card pool refill that waits for the game to end
 static void mine_sweeper_game_screen_view_enter(void* context);
 static void mine_sweeper_game_screen_view_exit(void* context);
 
@@ -175,464 +147,320 @@ static bool mine_sweeper_game_screen_view_play_input_callback(InputEvent* event,
  * Function definitions
  *************************************************************/
 
-/**
- * This function is called on alloc, reset, and win/lose condition.
- * It sets up a random board to be checked by the verifier
- */
-static void setup_board(MineSweeperGameScreen* instance) {
-    furi_assert(instance);
-
-    uint16_t board_tile_count = 0;
-    uint8_t board_width = 0, board_height = 0, board_difficulty = 0;
-
-    with_view_model(
-        instance->view,
-        MineSweeperGameScreenModel * model,
-        {
-            board_width = model->board_width;
-            board_height = model->board_height;
-            board_tile_count =  (model->board_width*model->board_height);
-            board_difficulty = model->board_difficulty;
-        },
-        false
-    );
-
-    uint16_t num_mines = board_tile_count * difficulty_multiplier[ board_difficulty ];
+static MineSweeperBoardConfig mine_sweeper_game_screen_make_board_config(
+        MineSweeperGameScreen* instance,
+        uint8_t width,
+        uint8_t height,
+        uint8_t difficulty,
+        bool is_solvable) {
 
-    /** We can use a temporary buffer to set the tile types initially
-     * and manipulate then save to actual model
-     */
-    MineSweeperGameScreenTileType tiles[MINESWEEPER_BOARD_MAX_TILES];
-    memset(&tiles, MineSweeperGameScreenTileZero, sizeof(tiles));
+    // These are the min/max values that can actually be set
+    if (width  > 146) {width = 146;}
+    if (width  < 16 ) {width = 16;}
+    if (height > 64 ) {height = 64;}
+    if (height < 7  ) {height = 7;}
+    if (difficulty > 2 ) {difficulty = 2;}
 
-    // Randomly place mines except in the corners to help guarantee solvability
-    for (uint16_t i = 0; i < num_mines; i++) {
+    // Settings the heap can not hold are shrunk until they fit, rows first
+    while (height > 7 && !is_board_in_memory_budget(width, height)) {height--;}
+    while (width > 16 && !is_board_in_memory_budget(width, height)) {width--;}
+
+    const uint16_t median_3bv = (uint32_t)width * height * median_3bv_per_mille[difficulty] / 1000;
+
+    return (MineSweeperBoardConfig) {
+        .width = width,
+        .height = height,
+        .difficulty = difficulty,
+        .ensure_solvable = is_solvable,
+        .min_3bv = (instance->band_3bv == MineSweeper3bvBandHigh) ? median_3bv : 0,
+        .max_3bv = (instance->band_3bv == MineSweeper3bvBandLow) ? median_3bv : 0,
+        .min_difficulty = {.deepest_rule = (instance->band_logic == MineSweeperLogicBandSubsets) ? MineSweeperVerifierRuleSubset : 0},
+        .max_difficulty = {.deepest_rule = (instance->band_logic == MineSweeperLogicBandSimple) ? MineSweeperVerifierRuleSingle : 0},
+    };
+}
 
-        uint16_t rand_pos;
-        uint16_t x;
-        uint16_t y;
-        bool is_invalid_position;
-        do {
+static void mine_sweeper_game_screen_set_board_information(
+        MineSweeperGameScreenModel* model,
+        const MineSweeperBoardConfig* config) {
 
-            rand_pos = furi_hal_random_get() % board_tile_count;
-            x = rand_pos / board_width;
-            y = rand_pos % board_width;
+    furi_assert(model);
+    furi_assert(config);
 
-            is_invalid_position = ((rand_pos == 0)                      ||
-                                         (x==0 && y==1)                 ||
-                                         (x==1 && y==0)                 ||
-                                         rand_pos == board_tile_count-1 ||
-                                         (x==0 && y==board_width-1)     ||
-                                         (x==board_height-1 && y==0));
+    model->board_width = config->width;
+    model->board_height = config->height;
+    set_board_geometry(&model->geometry, config->width, config->height);
+    model->board_difficulty = config->difficulty;
+    model->ensure_solvable_board = config->ensure_solvable;
+}
 
+/**
+ * Swaps the board the generator finished into the view model and resets the game state for it.
+ * Only the board pointers are exchanged, so the model lock is held for a constant time.
+ * The board information is only written here so the current game is untouched while a board is generated.
+ *
+ * Returns false if the generator has no finished board.
+ */
+static bool mine_sweeper_game_screen_install_board(MineSweeperGameScreen* instance) {
+    furi_assert(instance);
 
-        } while (tiles[rand_pos] == MineSweeperGameScreenTileMine || is_invalid_position);
+    MineSweeperBoardConfig config;
+    uint64_t seed = 0;
 
-        tiles[rand_pos] = MineSweeperGameScreenTileMine;
+    if (mine_sweeper_board_generator_get_progress(instance->generator).state != MineSweeperBoardGeneratorStateDone ||
+        !mine_sweeper_board_generator_get_job(instance->generator, &config, &seed)) {
+        return false;
     }
 
-    /** All mines are set so we look at each tile for surrounding mines */
-    for (uint16_t i = 0; i < board_tile_count; i++) {
-        MineSweeperGameScreenTileType tile_type = tiles[i];
-
-        if (tile_type == MineSweeperGameScreenTileMine) {
-            continue;
-        }
-
-        uint16_t mine_count = 0;
-
-        uint16_t x = i / board_width;
-        uint16_t y = i % board_width;
-
-        for (uint8_t j = 0; j < 8; j++) {
-            int16_t dx = x + (int16_t)offsets[j][0];
-            int16_t dy = y + (int16_t)offsets[j][1];
-
-            if (dx < 0 || dy < 0 || dx >= board_height || dy >= board_width) {
-                continue;
-            }
-
-            uint16_t pos = dx * board_width + dy;
-            if (tiles[pos] == MineSweeperGameScreenTileMine) {
-                mine_count++;
-            }
-
-        }
-
-        tiles[i] = (MineSweeperGameScreenTileType) mine_count+1;
-
-    }
+    // The worker may still be returning from its last progress callback
+    mine_sweeper_board_generator_wait(instance->generator);
 
-    // Save tiles to view model
-    // Because of way tile enum and tile_icons array is set up we can
-    // index tile_icons with the enum type to get the correct Icon*
     with_view_model(
         instance->view,
         MineSweeperGameScreenModel * model,
         {
-            for (uint16_t i = 0; i < board_tile_count; i++) {
-                model->board[i].tile_type = tiles[i];
-                model->board[i].tile_state = MineSweeperGameScreenTileStateUncleared;
-                model->board[i].icon_element.icon = tile_icons[ tiles[i] ];
-                model->board[i].icon_element.x_abs = (i/model->board_width);
-                model->board[i].icon_element.y_abs = (i%model->board_width);
-            }
-
+            uint16_t num_mines = 0;
+            model->board = mine_sweeper_board_generator_swap(
+                    instance->generator, model->board, &model->board_size, &num_mines);
+            furi_check(resize_visited_set(&model->visited, config.width, config.height));
+            furi_check(resize_tile_queue(&model->queue, config.width, config.height));
+            furi_check(resize_uncleared_index(&model->uncleared, config.width, config.height));
+
+            mine_sweeper_game_screen_set_board_information(model, &config);
+            reset_uncleared_index(&model->uncleared, model->board, &model->geometry);
             model->mines_left = num_mines;
             model->flags_left = num_mines;
             model->tiles_left = (model->board_width * model->board_height) - model->mines_left;
-            model->curr_pos.x_abs = 0;
-            model->curr_pos.y_abs = 0;
-            model->right_boundary = MINESWEEPER_SCREEN_TILE_WIDTH;
-            model->bottom_boundary = MINESWEEPER_SCREEN_TILE_HEIGHT;
             model->is_restart_triggered = false;         
             model->has_lost_game = false;
+            model->is_board_pending = false;
+            model->board_seed = seed;
+            model->board_3bv = get_live_board_3bv(model->board, &model->geometry, &model->visited, &model->queue);
+
+            if (config.has_first_move) {
+                // The player is already on the first move, so keep the view where it is and open it
+                model->tiles_left -= play_tile_clear(
+                                        model->board,
+                                        &model->geometry,
+                                        &model->visited,
+                                        &model->queue,
+                                        &model->uncleared,
+                                        config.first_move.x,
+                                        config.first_move.y);
+            } else {
+                model->curr_pos.x_abs = 0;
+                model->curr_pos.y_abs = 0;
+                model->right_boundary = MINESWEEPER_SCREEN_TILE_WIDTH;
+                model->bottom_boundary = MINESWEEPER_SCREEN_TILE_HEIGHT;
+            }
         },
         true
     );
 
-}
-
-/**
- *  This function serves as the verifier for a board to check whether it has to be solved ambiguously or not
- *
- *  Returns true if it is unambiguously solvable.
- */
-static bool check_board_with_verifier(
-        MineSweeperTile* board,
-        const uint8_t board_width,
-        const uint8_t board_height,
-        uint16_t total_mines) {
-
-    furi_assert(board);
-
-    // Double ended queue used to track edges.
-    point_deq_t deq;
-    point_set_t visited;
-    
-    // Ordered Set for visited points
-    point_deq_init(deq);
-    point_set_init(visited);
-
-    bool is_solvable = false;
-
-    // Point_t pos will be used to keep track of the current point
-    Point_t pos;
-    pointobj_init(pos);
-
-    // Starting position is 0,0
-    Point start_pos = (Point){.x = 0, .y = 0};
-    pointobj_set_point(pos, start_pos);
-
-    // Initially bfs clear from 0,0 as it is safe. We should push all 'edges' found
-    // into the deq and this will be where we start off from
-    bfs_tile_clear_verifier(board, board_width, board_height, 0, 0, &deq, &visited);
-                                                             
-    //While we have valid edges to check and have not solved the board
-    while (!is_solvable && point_deq_size(deq) > 0) {
-
-        bool is_stuck = true; // This variable will track if any flag was placed for any edge to see if we are stuck
-                              
-        uint16_t deq_size = point_deq_size(deq);
-
-        // Iterate through all edge tiles and push new ones on
-        while (deq_size-- > 0) {
-
-            // Pop point and get 1d position in buffer
-            point_deq_pop_front(&pos, deq);
-            const Point curr_pos = pointobj_get_point(pos);
-            const uint16_t curr_pos_1d = curr_pos.x * board_width + curr_pos.y;
-
-            // Get tile at 1d position
-            MineSweeperTile tile = board[curr_pos_1d];
-            uint8_t tile_num = tile.tile_type - 1;
-            
-            // Track total surrounding tiles and flagged tiles
-            uint8_t num_surrounding_tiles = 0;
-            uint8_t num_flagged_tiles = 0;
-
-            for (uint8_t j = 0; j < 8; j++) {
-                const int16_t dx = curr_pos.x + (int16_t)offsets[j][0];
-                const int16_t dy = curr_pos.y + (int16_t)offsets[j][1];
-
-                if (dx < 0 || dy < 0 || dx >= board_height || dy >= board_width) {
-                    continue;
-                }
-
-                const uint16_t pos_1d = dx * board_width + dy;
-                if (board[pos_1d].tile_state == MineSweeperGameScreenTileStateUncleared) {
-                    num_surrounding_tiles++;
-                } else if (board[pos_1d].tile_state == MineSweeperGameScreenTileStateFlagged) {
-                    num_surrounding_tiles++;
-                    num_flagged_tiles++;
-                }
-
-            }
-            
-            if (num_flagged_tiles == tile_num) {
-                
-                // If the tile has the same number of surrounding flags as its type we bfs clear the uncleared surrounding tiles
-                // pushing new unvisited edges on deq
-
-                for (uint8_t j = 0; j < 8; j++) {
-                    const int16_t dx = curr_pos.x + (int16_t)offsets[j][0];
-                    const int16_t dy = curr_pos.y + (int16_t)offsets[j][1];
-
-                    if (dx < 0 || dy < 0 || dx >= board_height || dy >= board_width) {
-                        continue;
-                    }
-
-                    const uint16_t pos_1d = dx * board_width + dy;
-                    if (board[pos_1d].tile_state == MineSweeperGameScreenTileStateUncleared) {
-                        bfs_tile_clear_verifier(board, board_width, board_height, dx, dy, &deq, &visited);
-                    }
-
-                }
-
-                is_stuck = false;
-
-            } else if (num_surrounding_tiles == tile_num) {
-
-                // If the number of surrounding tiles is the tile num it is unambiguous so we place a flag on those tiles,
-                // decrement the mine count appropriately and check win condition, and then mark stuck as false
-
-                for (uint8_t j = 0; j < 8; j++) {
-                    const int16_t dx = curr_pos.x + (int16_t)offsets[j][0];
-                    const int16_t dy = curr_pos.y + (int16_t)offsets[j][1];
-
-                    if (dx < 0 || dy < 0 || dx >= board_height || dy >= board_width) {
-                        continue;
-                    }
-
-                    const uint16_t pos_1d = dx * board_width + dy;
-                    if (board[pos_1d].tile_state == MineSweeperGameScreenTileStateUncleared) {
-                        board[pos_1d].tile_state = MineSweeperGameScreenTileStateFlagged;
-                    }
-                }
-
-                total_mines -= (num_surrounding_tiles - num_flagged_tiles);
-
-                if (total_mines == 0) is_solvable = true;
-                 
-                is_stuck = false;
-
-            } else if (num_surrounding_tiles != 0) {
-
-                // If we have tiles around this position but the number of flagged tiles != tile num
-                // and the surrounding tiles != tile num this means the tile is ambiguous. We can push
-                // it back on the deq to be reprocessed with any other new edges
-                
-                point_deq_push_back(deq, pos);
-
-            }
-        }
-        
-        // If we are stuck we break as it is an ambiguous map generation
-        if (is_stuck) {
-            break;
-        }
+    FURI_LOG_I(MS_DEBUG_TAG, "Board generated from seed %016llX", (unsigned long long)seed);
+
+    // Get the next board ready while this one is being played. Verified boards go to the SD card pool,
+    // which is only refilled once the game is over or left, or while the player is idle. A key press stops
+    // an idle refill before it is handled, so the card is not written while a key press is being handled. A board built around the first move can only be generated
+    // once that move is known
+    instance->is_refill_pending = mine_sweeper_board_config_is_poolable(&config);
+    instance->is_idle_refill_running = false;
+    instance->last_input_tick = furi_get_tick();
+
+    if (instance->is_refill_pending) {
+        instance->refill_config = config;
+    } else if (!config.has_first_move) {
+        mine_sweeper_board_generator_start(
+                instance->generator,
+                &config,
+                mine_sweeper_rng_next64(&instance->rng),
+                mine_sweeper_board_config_has_band(&config) ? &generation_budget : NULL);
     }
 
-    point_set_clear(visited);
-    point_deq_clear(deq);
+    view_set_draw_callback(instance->view, mine_sweeper_game_screen_view_play_draw_callback);
+    view_set_input_callback(instance->view, mine_sweeper_game_screen_view_play_input_callback);
 
-    return is_solvable;
+    mine_sweeper_game_screen_reset_clock(instance);
 
+    return true;
 }
 
 /**
- * This is a bfs_tile clear used by the verifier which performs the normal tile clear
- * but also pushes new edges to the deq passed in. There is a separate function used
- * for the bfs_tile_clear used on the user click
+ * Starts the SD card pool refill install_board held back, if there is one.
+ * Called when the game is won or lost and when the game screen is left.
  */
-static void bfs_tile_clear_verifier(
-        MineSweeperTile* board,
-        const uint8_t board_width,
-        const uint8_t board_height,
-        const uint16_t x,
-        const uint16_t y,
-        point_deq_t* edges,
-        point_set_t* visited) {
-
-    furi_assert(board);
-    furi_assert(edges);
-    furi_assert(visited);
-    
-    // Init dequeue
-    point_deq_t deq;
-    point_deq_init(deq);
-    
-    // Point_t pos will be used to keep track of the current point
-    Point_t pos;
-    pointobj_init(pos);
-
-    // Starting position is current pos
-    Point start_pos = (Point){.x = x, .y = y};
-    pointobj_set_point(pos, start_pos);
+static void mine_sweeper_game_screen_start_pending_refill(MineSweeperGameScreen* instance) {
+    furi_assert(instance);
 
-    point_deq_push_back(deq, pos);
-    
-    while (point_deq_size(deq) > 0) {
+    if (!instance->is_refill_pending) {
+        return;
+    }
 
-        point_deq_pop_front(&pos, deq);
-        Point curr_pos = pointobj_get_point(pos);
-        uint16_t curr_pos_1d = curr_pos.x * board_width + curr_pos.y;
-        
-        // If in visited set or it is cleared continue
-        if (point_set_cget(*visited, pos) != NULL ||
-            board[curr_pos_1d].tile_state == MineSweeperGameScreenTileStateCleared ) {
-            continue;
-        } 
+    instance->is_refill_pending = false;
+    instance->is_idle_refill_running = false;
+    mine_sweeper_board_generator_start_refill(
+            instance->generator, &instance->refill_config, mine_sweeper_rng_next64(&instance->rng));
+}
 
-        // Add point to visited set
-        point_set_push(*visited, pos);
+/**
+ * Stops a refill started by idle time and waits for the worker. The refill checks for the cancel right before
+ * every write to the SD card, so the wait is at most one attempt or one write that was already under way,
+ * and nothing is written once the key press is handled.
+ * The refill is held back again until the game ends or the player is idle once more.
+ */
+static void mine_sweeper_game_screen_stop_idle_refill(MineSweeperGameScreen* instance) {
+    furi_assert(instance);
 
-        // Else set tile to cleared
-        board[curr_pos_1d].tile_state = MineSweeperGameScreenTileStateCleared;
-        
+    if (!instance->is_idle_refill_running) {
+        return;
+    }
 
-        // When we hit a potential edge
-        if (board[curr_pos_1d].tile_type != MineSweeperGameScreenTileZero) {
+    instance->is_idle_refill_running = false;
+    instance->is_refill_pending = true;
+    mine_sweeper_board_generator_cancel(instance->generator);
+}
 
-            // Add to our passed in deq of edges
-            point_deq_push_back(*edges, pos);
+/**
+ * Blocking generation used by the reset functions, reuses the background job if it is building this exact board.
+ * The worker drops a band it finds no board in within the budget, which is kept short here because
+ * nothing is drawn while the GUI thread waits. Banded boards the player waits on for longer are left to
+ * the worker and the progress screen through the wait callback.
+ */
+static void mine_sweeper_game_screen_generate_board(
+        MineSweeperGameScreen* instance,
+        const MineSweeperBoardConfig* config,
+        uint64_t seed) {
 
-            // Continue processing next point for bfs tile clear
-            continue;
-        }
+    furi_assert(instance);
+    furi_assert(config);
+
+    MineSweeperBoardConfig job_config;
+    uint64_t job_seed = 0;
+
+    const bool is_banded = mine_sweeper_board_config_has_band(config);
+
+    // A running background job for a band has the full budget, so only a finished one is waited on
+    bool is_job_usable = mine_sweeper_board_generator_get_job(instance->generator, &job_config, &job_seed) &&
+                         mine_sweeper_board_config_equal(&job_config, config) &&
+                         job_seed == seed &&
+                         (!is_banded || mine_sweeper_board_generator_get_progress(instance->generator).state ==
+                                            MineSweeperBoardGeneratorStateDone);
+
+    if (!is_job_usable) {
+        mine_sweeper_board_generator_start(
+                instance->generator,
+                config,
+                seed,
+                is_banded ? &blocking_generation_budget : NULL);
+    }
 
+    mine_sweeper_board_generator_wait(instance->generator);
 
-        // Process all surrounding neighbors and add valid to dequeue
-        for (uint8_t i = 0; i < 8; i++) {
-            int16_t dx = curr_pos.x + (int16_t)offsets[i][0];
-            int16_t dy = curr_pos.y + (int16_t)offsets[i][1];
+    // A verified board may not be found without the band either in that budget, it is then built like any other
+    if (!mine_sweeper_game_screen_install_board(instance)) {
+        MineSweeperBoardConfig unbanded_config = *config;
+        unbanded_config.min_3bv = 0;
+        unbanded_config.max_3bv = 0;
+        unbanded_config.min_difficulty = (MineSweeperBoardDifficulty){0};
+        unbanded_config.max_difficulty = (MineSweeperBoardDifficulty){0};
 
-            if (dx < 0 || dy < 0 || dx >= board_height || dy >= board_width) {
-                continue;
-            }
-            
-            Point neighbor = (Point) {.x = dx, .y = dy};
-            pointobj_set_point(pos, neighbor);
+        mine_sweeper_board_generator_start(instance->generator, &unbanded_config, seed, NULL);
+        mine_sweeper_board_generator_wait(instance->generator);
+        furi_check(mine_sweeper_game_screen_install_board(instance));
+    }
+}
 
-            if (point_set_cget(*visited, pos) != NULL) continue;
+static void mine_sweeper_game_screen_start_budgeted_job(
+        MineSweeperGameScreen* instance,
+        const MineSweeperBoardConfig* config) {
 
-            point_deq_push_back(deq, pos);
-        }
-    }
+    furi_assert(instance);
+    furi_assert(config);
 
-    point_deq_clear(deq);
+    mine_sweeper_board_generator_start(instance->generator, config, mine_sweeper_rng_next64(&instance->rng), &generation_budget);
 }
 
 /**
- * This is a bfs_tile clear used in the input callbacks to clear the board on user input
+ * Starts a game on a board without mines that is only generated on the first OK press.
+ * Every tile is drawn as uncleared and the counters already show the mines the board will have.
  */
-static uint16_t bfs_tile_clear(
-        MineSweeperTile* board,
-        const uint8_t board_width,
-        const uint8_t board_height,
-        const uint16_t x,
-        const uint16_t y) {
-
-    furi_assert(board);
-
-    // We will return this number as the number of tiles cleared
-    uint16_t ret = 0;
-    
-    // Init both the set and dequeue
-    point_deq_t deq;
-    point_set_t set;
-
-    point_deq_init(deq);
-    point_set_init(set);
-
-    // Point_t pos will be used to keep track of the current point
-    Point_t pos;
-    pointobj_init(pos);
-
-    // Starting position is current pos
-    Point start_pos = (Point){.x = x, .y = y};
-    pointobj_set_point(pos, start_pos);
+static void mine_sweeper_game_screen_reset_pending(
+        MineSweeperGameScreen* instance,
+        const MineSweeperBoardConfig* config) {
 
-    point_deq_push_back(deq, pos);
-    
-    while (point_deq_size(deq) > 0) {
+    furi_assert(instance);
+    furi_assert(config);
 
-        point_deq_pop_front(&pos, deq);
-        Point curr_pos = pointobj_get_point(pos);
-        uint16_t curr_pos_1d = curr_pos.x * board_width + curr_pos.y;
-        
-        // If it has been visited cleared or flagged continue
-        if (point_set_cget(set, pos) != NULL ||
-            board[curr_pos_1d].tile_state == MineSweeperGameScreenTileStateCleared || 
-            board[curr_pos_1d].tile_state == MineSweeperGameScreenTileStateFlagged) {
-            continue;
-        }
-        
-        // Else set tile to cleared
-        board[curr_pos_1d].tile_state = MineSweeperGameScreenTileStateCleared;
-        
-        // Add point to visited set
-        point_set_push(set, pos);
+    // A board generated for an earlier game is of no use anymore, an idle refill is held back again
+    mine_sweeper_game_screen_stop_idle_refill(instance);
+    mine_sweeper_board_generator_cancel(instance->generator);
 
-        // Increment total number of cleared tiles
-        ret++;
+    with_view_model(
+        instance->view,
+        MineSweeperGameScreenModel * model,
+        {
+            // The pending game keeps its board, only a board of another size is allocated again
+            furi_check(resize_board(&model->board, &model->board_size, config->width, config->height));
+            furi_check(resize_visited_set(&model->visited, config->width, config->height));
+            furi_check(resize_tile_queue(&model->queue, config->width, config->height));
+            furi_check(resize_uncleared_index(&model->uncleared, config->width, config->height));
 
-        // If it is not a zero tile continue
-        if (board[curr_pos_1d].tile_type != MineSweeperGameScreenTileZero) {
-            continue;
-        }
+            mine_sweeper_game_screen_set_board_information(model, config);
 
-        // Process all surrounding neighbors and add valid to dequeue
-        for (uint8_t i = 0; i < 8; i++) {
-            int16_t dx = curr_pos.x + (int16_t)offsets[i][0];
-            int16_t dy = curr_pos.y + (int16_t)offsets[i][1];
+            uint16_t board_tile_count = model->board_width * model->board_height;
 
-            if (dx < 0 || dy < 0 || dx >= board_height || dy >= board_width) {
-                continue;
-            }
-            
-            Point neighbor = (Point) {.x = dx, .y = dy};
-            pointobj_set_point(pos, neighbor);
+            clear_board(model->board, model->board_width, model->board_height, MineSweeperGameScreenTileNone);
+            reset_uncleared_index(&model->uncleared, model->board, &model->geometry);
 
-            if (point_set_cget(set, pos) != NULL) continue;
+            model->mines_left = get_board_mine_count(model->board_width, model->board_height, model->board_difficulty);
+            model->flags_left = model->mines_left;
+            model->tiles_left = board_tile_count - model->mines_left;
+            model->curr_pos.x_abs = 0;
+            model->curr_pos.y_abs = 0;
+            model->right_boundary = MINESWEEPER_SCREEN_TILE_WIDTH;
+            model->bottom_boundary = MINESWEEPER_SCREEN_TILE_HEIGHT;
+            model->is_restart_triggered = false;         
+            model->has_lost_game = false;
+            model->is_board_pending = true;
+            model->board_seed = 0;
+            model->board_3bv = 0;
+        },
+        true
+    );
 
-            point_deq_push_back(deq, pos);
-        }
-    }
+    view_set_draw_callback(instance->view, mine_sweeper_game_screen_view_play_draw_callback);
+    view_set_input_callback(instance->view, mine_sweeper_game_screen_view_play_input_callback);
 
-    point_set_clear(set);
-    point_deq_clear(deq);
-    
-    return ret;
+    mine_sweeper_game_screen_reset_clock(instance);
 }
 
-static void mine_sweeper_game_screen_set_board_information(
+/**
+ * Generates the pending board around the tile the player just pressed OK on.
+ * Unverified boards take no noticeable time so they are built right here, verified and banded
+ * boards are left to the worker and the app is told to wait for them when it can.
+ */
+static void mine_sweeper_game_screen_generate_first_move(
         MineSweeperGameScreen* instance,
-        uint8_t width,
-        uint8_t height,
-        uint8_t difficulty,
-        bool is_solvable) {
+        MineSweeperGameScreenModel* model) {
 
     furi_assert(instance);
+    furi_assert(model);
 
-    // These are the min/max values that can actually be set
-    if (width  > 146) {width = 146;}
-    if (width  < 16 ) {width = 16;}
-    if (height > 64 ) {height = 64;}
-    if (height < 7  ) {height = 7;}
-    if (difficulty > 2 ) {difficulty = 2;}
-    
-    with_view_model(
-        instance->view,
-        MineSweeperGameScreenModel * model,
-        {
-            model->board_width = width;
-            model->board_height = height;
-            model->board_difficulty = difficulty;
-            model->ensure_solvable_board = is_solvable;
-        },
-        true
-    );
+    MineSweeperBoardConfig config = mine_sweeper_game_screen_make_board_config(
+            instance,
+            model->board_width,
+            model->board_height,
+            model->board_difficulty,
+            model->ensure_solvable_board);
+
+    config.has_first_move = true;
+    config.first_move = (Point) {.x = model->curr_pos.x_abs, .y = model->curr_pos.y_abs};
+
+    if ((config.ensure_solvable || mine_sweeper_board_config_has_band(&config)) && instance->wait_callback != NULL) {
+        mine_sweeper_game_screen_start_budgeted_job(instance, &config);
+        instance->wait_callback(instance->context);
+    } else {
+        mine_sweeper_game_screen_generate_board(instance, &config, mine_sweeper_rng_next64(&instance->rng));
+    }
 }
 
 // THIS FUNCTION CAN TRIGGER THE LOSE CONDITION
@@ -643,8 +471,9 @@ static bool try_clear_surrounding_tiles(MineSweeperGameScreenModel* model) {
     uint8_t curr_x = model->curr_pos.x_abs;
     uint8_t curr_y = model->curr_pos.y_abs;
     uint8_t board_width = model->board_width;
-    uint8_t board_height = model->board_height;
-    uint16_t curr_pos_1d = curr_x * board_width + curr_y;
+    uint16_t curr_pos_1d = get_board_index(board_width, curr_x, curr_y);
+
+    const int16_t* neighbor_offsets = model->geometry.neighbor_offsets;
 
     MineSweeperTile tile = model->board[curr_pos_1d];
 
@@ -654,48 +483,27 @@ static bool try_clear_surrounding_tiles(MineSweeperGameScreenModel* model) {
     }
 
     uint8_t num_surrounding_flagged = 0;
-    bool was_mine_found = false;
     bool is_lose_condition_triggered = false;
 
+    // Border tiles are never flagged, so they need no bounds checks
     for (uint8_t j = 0; j < 8; j++) {
-        int16_t dx = curr_x + (int16_t)offsets[j][0];
-        int16_t dy = curr_y + (int16_t)offsets[j][1];
-
-        if (dx < 0 || dy < 0 || dx >= board_height || dy >= board_width) {
-            continue;
-        }
-
-        uint16_t pos = dx * board_width + dy;
+        uint16_t pos = curr_pos_1d + neighbor_offsets[j];
         if (model->board[pos].tile_state == MineSweeperGameScreenTileStateFlagged) {
             num_surrounding_flagged++;
-        } else if (!was_mine_found && model->board[pos].tile_type == MineSweeperGameScreenTileMine
-                && model->board[pos].tile_state != MineSweeperGameScreenTileStateFlagged) {
-            was_mine_found = true;
         }
-
     }
 
-    // We clear surrounding tile
+    // We clear surrounding tiles in one flood, which also tells if one of them was a mine
     if (num_surrounding_flagged >= tile.tile_type-1) {
-        if (was_mine_found) is_lose_condition_triggered = true;
-
-
-        for (uint8_t j = 0; j < 8; j++) {
-            int16_t dx = curr_x + (int16_t)offsets[j][0];
-            int16_t dy = curr_y + (int16_t)offsets[j][1];
-
-            if (dx < 0 || dy < 0 || dx >= board_height || dy >= board_width) {
-                continue;
-            }
-
-            uint16_t pos = dx * board_width + dy;
-            if (model->board[pos].tile_state == MineSweeperGameScreenTileStateUncleared) {
-                // Decrement tiles left by the amount cleared
-                uint16_t tiles_cleared = bfs_tile_clear(model->board, model->board_width, model->board_height, dx, dy);
-                model->tiles_left -= tiles_cleared;
-            }
-
-        }
+        model->tiles_left -= play_chord_clear(
+                model->board,
+                &model->geometry,
+                &model->visited,
+                &model->queue,
+                &model->uncleared,
+                curr_x,
+                curr_y,
+                &is_lose_condition_triggered);
     }
 
     return is_lose_condition_triggered;
@@ -703,107 +511,20 @@ static bool try_clear_surrounding_tiles(MineSweeperGameScreenModel* model) {
 }
 
 /**
- * Function is used on a long backpress on a cleared tile and returns the position
- * of the first found uncleared tile using a bfs search
+ * Function is used on a long backpress on a cleared tile and moves the cursor
+ * to the closest uncleared tile, looked up in the uncleared index of the board
  */
-static void bfs_to_closest_tile(MineSweeperGameScreen* instance, MineSweeperGameScreenModel* model) {
+static void move_to_closest_uncleared_tile(MineSweeperGameScreen* instance, MineSweeperGameScreenModel* model) {
 
     furi_assert(model);
 
-    point_deq_t deq2;
-    point_deq_init(deq2);
-
-    // Init both the set and dequeue
-    point_deq_t deq;
-    point_set_t set;
-
-    point_deq_init(deq);
-    point_set_init(set);
-
-    // Return the value in this point
-    Point result = (Point) {.x = 0, .y = 0};
-
-    // Point_t pos will be used to keep track of the current point
-    Point_t pos;
-    pointobj_init(pos);
-
-    // Starting position is current position of the model
-    Point start_pos = (Point){.x = model->curr_pos.x_abs, .y = model->curr_pos.y_abs};
-    pointobj_set_point(pos, start_pos);
-
-    point_deq_push_back(deq, pos);
-
-    bool is_first_uncleared_tile_found = false;
-
-    while (point_deq_size(deq) > 0) {
-        point_deq_pop_front(&pos, deq);
-        Point curr_pos = pointobj_get_point(pos);
-        uint16_t curr_pos_1d = curr_pos.x * model->board_width + curr_pos.y;
+    Point result;
 
-        // If we have already visited this tile continue
-        if (point_set_cget(set, pos) != NULL) {
-            continue;
-        } 
-
-        // Add point to visited set
-        point_set_push(set, pos);
-
-        // Do not continue if we have found some valid tiles and this is a cleared tiled
-        if (is_first_uncleared_tile_found &&
-            model->board[curr_pos_1d].tile_state == MineSweeperGameScreenTileStateCleared) {
-            continue;
-        }
-        
-        // Add this potential candidate tile to the other deque to be compared with other candidates
-        if (model->board[curr_pos_1d].tile_state == MineSweeperGameScreenTileStateUncleared) {
-            
-            if (!is_first_uncleared_tile_found)
-                is_first_uncleared_tile_found = true;
-            
-            pointobj_set_point(pos, curr_pos);
-            point_deq_push_back(deq2, pos);
-            continue;
-        }
-
-        // Process all surrounding neighbors for cleared tiles and add valid to dequeue
-        for (uint8_t i = 0; i < 8; i++) {
-            int16_t dx = curr_pos.x + (int16_t)offsets[i][0];
-            int16_t dy = curr_pos.y + (int16_t)offsets[i][1];
-
-            if (dx < 0 || dy < 0 || dx >= model->board_height || dy >= model->board_width) {
-                continue;
-            }
-                
-            Point neighbor = (Point) {.x = dx, .y = dy};
-            pointobj_set_point(pos, neighbor);
-            point_deq_push_back(deq, pos);
-        }
+    // Nothing is left to move to once every tile is cleared or flagged
+    if (!find_closest_uncleared_tile(&model->uncleared, model->curr_pos.x_abs, model->curr_pos.y_abs, &result)) {
+        return;
     }
 
-    point_set_clear(set);
-    point_deq_clear(deq);
-    
-    // Loop through all valid candidates and save the one with lowest euclidean distance
-    double min_distance = INT_MAX;
-
-    while (point_deq_size(deq2) > 0) {
-        point_deq_pop_front(&pos, deq2);
-        Point curr_pos = pointobj_get_point(pos);
-        int x_abs = abs(curr_pos.x - start_pos.x); 
-        int y_abs = abs(curr_pos.y - start_pos.y); 
-        double distance = sqrt(x_abs*x_abs + y_abs*y_abs);
-
-        if (distance < min_distance) {
-            result = curr_pos;
-            min_distance = distance;
-        } else if (distance == min_distance && (furi_hal_random_get() % 2) == 0) {
-            result = curr_pos;
-            min_distance = distance;
-        }
-    }
-
-    point_deq_clear(deq2);
-
     // Save cursor to new closest tile position
     // If the cursor moves outisde of the model boundaries we need to
     // move the boundary appropriately
@@ -1014,33 +735,42 @@ static int8_t handle_short_ok_input(MineSweeperGameScreen* instance, MineSweeper
     furi_assert(instance);
     furi_assert(model);
     
-    uint16_t curr_pos_1d = model->curr_pos.x_abs * model->board_width + model->curr_pos.y_abs;
+    uint16_t curr_pos_1d = get_board_index(model->board_width, model->curr_pos.x_abs, model->curr_pos.y_abs);
     bool is_win_condition_triggered = false;
     bool is_lose_condition_triggered = false;
 
     MineSweeperGameScreenTileState state = model->board[curr_pos_1d].tile_state;
     MineSweeperGameScreenTileType type = model->board[curr_pos_1d].tile_type;
 
-    if (state == MineSweeperGameScreenTileStateUncleared && type == MineSweeperGameScreenTileMine) {
+    if (model->is_board_pending) {
+
+        // The first move places the mines, so it can never hit one
+        mine_sweeper_game_screen_generate_first_move(instance, model);
+
+    } else if (state == MineSweeperGameScreenTileStateUncleared && type == MineSweeperGameScreenTileMine) {
 
         // If the user short presses OK on a mine they lose
         is_lose_condition_triggered = true;
         model->board[curr_pos_1d].tile_state = MineSweeperGameScreenTileStateCleared;
+        update_uncleared_index(&model->uncleared, model->board, curr_pos_1d);
+        refresh_frontier(&model->uncleared, model->board, &model->geometry);
 
     } else if (state == MineSweeperGameScreenTileStateUncleared) {
         
         // The user can win if the last tiles are cleared and all flags are correctly set
 
-        uint16_t tiles_cleared = bfs_tile_clear(
+        uint16_t tiles_cleared = play_tile_clear(
                                     model->board,
-                                    model->board_width,
-                                    model->board_height,
+                                    &model->geometry,
+                                    &model->visited,
+                                    &model->queue,
+                                    &model->uncleared,
                                     (uint16_t)model->curr_pos.x_abs,
                                     (uint16_t)model->curr_pos.y_abs);
 
         model->tiles_left -= tiles_cleared;
 
-        if (model->mines_left == 0 && model->flags_left == 0 && model->tiles_left == 0) {
+        if (is_board_won(&model->uncleared, model->mines_left, model->flags_left, model->tiles_left)) {
             is_win_condition_triggered = true;
         }
     }
@@ -1061,7 +791,7 @@ static int8_t handle_long_ok_input(MineSweeperGameScreen* instance, MineSweeperG
     furi_assert(instance);
     furi_assert(model);
     
-    uint16_t curr_pos_1d = model->curr_pos.x_abs * model->board_width + model->curr_pos.y_abs;
+    uint16_t curr_pos_1d = get_board_index(model->board_width, model->curr_pos.x_abs, model->curr_pos.y_abs);
     bool is_win_condition_triggered = false;
     bool is_lose_condition_triggered = false;
 
@@ -1072,7 +802,7 @@ static int8_t handle_long_ok_input(MineSweeperGameScreen* instance, MineSweeperG
     model->is_holding_down_button = true;
 
     // Check win condition
-    if (model->mines_left == 0 && model->flags_left == 0 && model->tiles_left == 0) {
+    if (is_board_won(&model->uncleared, model->mines_left, model->flags_left, model->tiles_left)) {
         is_win_condition_triggered = true;
     }
 
@@ -1094,7 +824,7 @@ static bool handle_long_back_flag_input(MineSweeperGameScreen* instance, MineSwe
     furi_assert(instance);
     furi_assert(model);
     
-    uint16_t curr_pos_1d = model->curr_pos.x_abs * model->board_width + model->curr_pos.y_abs;
+    uint16_t curr_pos_1d = get_board_index(model->board_width, model->curr_pos.x_abs, model->curr_pos.y_abs);
     MineSweeperGameScreenTileState state = model->board[curr_pos_1d].tile_state;
     
     bool is_win_condition_triggered = false;
@@ -1102,16 +832,18 @@ static bool handle_long_back_flag_input(MineSweeperGameScreen* instance, MineSwe
     if (state == MineSweeperGameScreenTileStateFlagged) {
         if (model->board[curr_pos_1d].tile_type == MineSweeperGameScreenTileMine) model->mines_left++;
         model->board[curr_pos_1d].tile_state = MineSweeperGameScreenTileStateUncleared;
+        update_uncleared_index(&model->uncleared, model->board, curr_pos_1d);
         model->flags_left++;
     
     } else if (model->flags_left > 0) {
         if (model->board[curr_pos_1d].tile_type == MineSweeperGameScreenTileMine) model->mines_left--;
         model->board[curr_pos_1d].tile_state = MineSweeperGameScreenTileStateFlagged;
+        update_uncleared_index(&model->uncleared, model->board, curr_pos_1d);
         model->flags_left--;
     }
 
     // This can be a win condition where the non-mine tiles are cleared and they place the last flag
-    if (model->flags_left == 0 && model->mines_left == 0 && model->tiles_left == 0) {
+    if (is_board_won(&model->uncleared, model->mines_left, model->flags_left, model->tiles_left)) {
         is_win_condition_triggered = true;
         mine_sweeper_win_effect(instance);
     } else {
@@ -1129,7 +861,9 @@ static void mine_sweeper_game_screen_view_enter(void* context) {
 
 static void mine_sweeper_game_screen_view_exit(void* context) {
     furi_assert(context);
-    UNUSED(context);
+    MineSweeperGameScreen* instance = context;
+
+    mine_sweeper_game_screen_start_pending_refill(instance);
 }
 
 static void mine_sweeper_game_screen_view_end_draw_callback(Canvas* canvas, void* _model) {
@@ -1139,7 +873,7 @@ static void mine_sweeper_game_screen_view_end_draw_callback(Canvas* canvas, void
 
     canvas_clear(canvas);
 
-    uint16_t cursor_pos_1d = model->curr_pos.x_abs * model->board_width + model->curr_pos.y_abs;
+    uint16_t cursor_pos_1d = get_board_index(model->board_width, model->curr_pos.x_abs, model->curr_pos.y_abs);
     
     for (uint8_t x_rel = 0; x_rel < MINESWEEPER_SCREEN_TILE_HEIGHT; x_rel++) {
         uint16_t x_abs = (model->bottom_boundary - MINESWEEPER_SCREEN_TILE_HEIGHT) + x_rel;
@@ -1147,7 +881,7 @@ static void mine_sweeper_game_screen_view_end_draw_callback(Canvas* canvas, void
         for (uint8_t y_rel = 0; y_rel < MINESWEEPER_SCREEN_TILE_WIDTH; y_rel++) {
             uint16_t y_abs = (model->right_boundary - MINESWEEPER_SCREEN_TILE_WIDTH) + y_rel;
 
-            uint16_t curr_rendering_tile_pos_1d = x_abs * model->board_width + y_abs;
+            uint16_t curr_rendering_tile_pos_1d = get_board_index(model->board_width, x_abs, y_abs);
             MineSweeperTile tile = model->board[curr_rendering_tile_pos_1d];
 
             if (cursor_pos_1d == curr_rendering_tile_pos_1d) {
@@ -1158,9 +892,9 @@ static void mine_sweeper_game_screen_view_end_draw_callback(Canvas* canvas, void
 
             canvas_draw_icon(
                 canvas,
-                y_rel * icon_get_width(tile.icon_element.icon),
-                x_rel * icon_get_height(tile.icon_element.icon),
-                tile.icon_element.icon);
+                y_rel * icon_get_width(tile_icons[ tile.tile_type ]),
+                x_rel * icon_get_height(tile_icons[ tile.tile_type ]),
+                tile_icons[ tile.tile_type ]);
 
         }
     }
@@ -1240,7 +974,7 @@ static void mine_sweeper_game_screen_view_play_draw_callback(Canvas* canvas, voi
     canvas_clear(canvas);
 
     
-    uint16_t cursor_pos_1d = model->curr_pos.x_abs * model->board_width + model->curr_pos.y_abs;
+    uint16_t cursor_pos_1d = get_board_index(model->board_width, model->curr_pos.x_abs, model->curr_pos.y_abs);
     
     for (uint8_t x_rel = 0; x_rel < MINESWEEPER_SCREEN_TILE_HEIGHT; x_rel++) {
         uint16_t x_abs = (model->bottom_boundary - MINESWEEPER_SCREEN_TILE_HEIGHT) + x_rel;
@@ -1248,7 +982,7 @@ static void mine_sweeper_game_screen_view_play_draw_callback(Canvas* canvas, voi
         for (uint8_t y_rel = 0; y_rel < MINESWEEPER_SCREEN_TILE_WIDTH; y_rel++) {
             uint16_t y_abs = (model->right_boundary - MINESWEEPER_SCREEN_TILE_WIDTH) + y_rel;
 
-            uint16_t curr_rendering_tile_pos_1d = x_abs * model->board_width + y_abs;
+            uint16_t curr_rendering_tile_pos_1d = get_board_index(model->board_width, x_abs, y_abs);
             MineSweeperTile tile = model->board[curr_rendering_tile_pos_1d];
 
             if (cursor_pos_1d == curr_rendering_tile_pos_1d) {
@@ -1262,25 +996,25 @@ static void mine_sweeper_game_screen_view_play_draw_callback(Canvas* canvas, voi
                 case MineSweeperGameScreenTileStateFlagged :
                     canvas_draw_icon(
                         canvas,
-                        y_rel * icon_get_width(tile.icon_element.icon),
-                        x_rel * icon_get_height(tile.icon_element.icon),
+                        y_rel * icon_get_width(tile_icons[ tile.tile_type ]),
+                        x_rel * icon_get_height(tile_icons[ tile.tile_type ]),
                         tile_icons[11]);
 
                     break;
                 case MineSweeperGameScreenTileStateUncleared :
                     canvas_draw_icon(
                         canvas,
-                        y_rel * icon_get_width(tile.icon_element.icon),
-                        x_rel * icon_get_height(tile.icon_element.icon),
+                        y_rel * icon_get_width(tile_icons[ tile.tile_type ]),
+                        x_rel * icon_get_height(tile_icons[ tile.tile_type ]),
                         tile_icons[12]);
 
                     break;
                 case MineSweeperGameScreenTileStateCleared :
                     canvas_draw_icon(
                         canvas,
-                        y_rel * icon_get_width(tile.icon_element.icon),
-                        x_rel * icon_get_height(tile.icon_element.icon),
-                        tile.icon_element.icon);
+                        y_rel * icon_get_width(tile_icons[ tile.tile_type ]),
+                        x_rel * icon_get_height(tile_icons[ tile.tile_type ]),
+                        tile_icons[ tile.tile_type ]);
                     break;
                 default:
                     break;
@@ -1406,12 +1140,39 @@ static bool mine_sweeper_game_screen_view_end_input_callback(InputEvent* event,
                 // After restart flagged is triggered this should also trigger and restart the game
 
                 mine_sweeper_led_reset(instance->context);
-                
-                mine_sweeper_game_screen_reset(instance,
-                                               model->board_width,
-                                               model->board_height,
-                                               model->board_difficulty,
-                                               model->ensure_solvable_board);
+
+                if (instance->is_first_move_enabled) {
+
+                    // Nothing to wait for, the board is generated on the first move
+                    mine_sweeper_game_screen_reset(instance,
+                                                   model->board_width,
+                                                   model->board_height,
+                                                   model->board_difficulty,
+                                                   model->ensure_solvable_board);
+
+                // The next board is usually already waiting or in the pool, otherwise let the app show the generation progress
+                } else if (!mine_sweeper_game_screen_apply_prepared_board(instance)) {
+
+                    mine_sweeper_game_screen_prepare(instance,
+                                                     model->board_width,
+                                                     model->board_height,
+                                                     model->board_difficulty,
+                                                     model->ensure_solvable_board);
+
+                    // Preparing may have taken a board from the pool
+                    if (!mine_sweeper_game_screen_apply_prepared_board(instance)) {
+
+                        if (instance->wait_callback != NULL) {
+                            instance->wait_callback(instance->context);
+                        } else {
+                            mine_sweeper_game_screen_reset(instance,
+                                                           model->board_width,
+                                                           model->board_height,
+                                                           model->board_difficulty,
+                                                           model->ensure_solvable_board);
+                        }
+                    }
+                }
 
                 consumed = true;
 
@@ -1434,7 +1195,10 @@ static bool mine_sweeper_game_screen_view_play_input_callback(InputEvent* event,
 
     MineSweeperGameScreen* instance = context;
     bool consumed = false;
+    bool is_game_ended = false;
 
+    instance->last_input_tick = furi_get_tick();
+    mine_sweeper_game_screen_stop_idle_refill(instance);
 
     with_view_model(
         instance->view,
@@ -1466,6 +1230,7 @@ static bool mine_sweeper_game_screen_view_play_input_callback(InputEvent* event,
                 if (input_result == -1) {
 
                     model->has_lost_game = true;
+                    is_game_ended = true;
 
                     view_set_draw_callback(instance->view, mine_sweeper_game_screen_view_end_draw_callback);
                     view_set_input_callback(instance->view, mine_sweeper_game_screen_view_end_input_callback);
@@ -1473,6 +1238,7 @@ static bool mine_sweeper_game_screen_view_play_input_callback(InputEvent* event,
                 } else if (input_result == 1) {
 
                     dolphin_deed(DolphinDeedPluginGameWin);
+                    is_game_ended = true;
 
                     view_set_draw_callback(instance->view, mine_sweeper_game_screen_view_end_draw_callback);
                     view_set_input_callback(instance->view, mine_sweeper_game_screen_view_end_input_callback);
@@ -1491,17 +1257,20 @@ static bool mine_sweeper_game_screen_view_play_input_callback(InputEvent* event,
                                                                                                 // us to the menu
 
 
-                    uint16_t curr_pos_1d = model->curr_pos.x_abs * model->board_width + model->curr_pos.y_abs;
+                    uint16_t curr_pos_1d = get_board_index(model->board_width, model->curr_pos.x_abs, model->curr_pos.y_abs);
                     MineSweeperGameScreenTileState state = model->board[curr_pos_1d].tile_state;
                     
                     if (state == MineSweeperGameScreenTileStateCleared) {
 
-                        // BFS to set user position to a closest covered tile 
-                        bfs_to_closest_tile(instance, model);
+                        // Move the cursor to the closest covered tile
+                        move_to_closest_uncleared_tile(instance, model);
 
                         model->is_holding_down_button = true;
 
-                    } else if (!model->is_holding_down_button && state != MineSweeperGameScreenTileStateCleared) { 
+                    } else if (!model->is_holding_down_button && !model->is_board_pending &&
+                               state != MineSweeperGameScreenTileStateCleared) {
+
+                        // Flags wait for the first move as there are no mines to count them against yet
 
                         // Flag or Unflag tile and check win condition 
                         bool is_win_condition_triggered = false;
@@ -1513,6 +1282,7 @@ static bool mine_sweeper_game_screen_view_play_input_callback(InputEvent* event,
                         if (is_win_condition_triggered) {
 
                             dolphin_deed(DolphinDeedPluginGameWin);
+                            is_game_ended = true;
                             
                             view_set_draw_callback(instance->view, mine_sweeper_game_screen_view_end_draw_callback);
                             view_set_input_callback(instance->view, mine_sweeper_game_screen_view_end_input_callback);
@@ -1531,7 +1301,11 @@ static bool mine_sweeper_game_screen_view_play_input_callback(InputEvent* event,
         },
         true
     );
-    
+
+    // The refill cancels and starts the worker, so it waits until the model is no longer locked
+    if (is_game_ended) {
+        mine_sweeper_game_screen_start_pending_refill(instance);
+    }
 
     if (!consumed && instance->input_callback != NULL) {
         consumed = instance->input_callback(event, instance->context);
@@ -1544,7 +1318,8 @@ MineSweeperGameScreen* mine_sweeper_game_screen_alloc(uint8_t width,
                                                       uint8_t height,
                                                       uint8_t difficulty,
                                                       bool ensure_solvable,
-                                                      uint8_t wrap_enable) {
+                                                      uint8_t wrap_enable,
+                                                      uint8_t first_move_enable) {
 
     MineSweeperGameScreen* mine_sweeper_game_screen = (MineSweeperGameScreen*)malloc(sizeof(MineSweeperGameScreen));
     
@@ -1556,12 +1331,24 @@ MineSweeperGameScreen* mine_sweeper_game_screen_alloc(uint8_t width,
     view_set_draw_callback(mine_sweeper_game_screen->view, mine_sweeper_game_screen_view_play_draw_callback);
     view_set_input_callback(mine_sweeper_game_screen->view, mine_sweeper_game_screen_view_play_input_callback);
     
-    // This are currently unused
+    // Enter is currently unused, exit starts a held back pool refill
     view_set_enter_callback(mine_sweeper_game_screen->view, mine_sweeper_game_screen_view_enter);
     view_set_exit_callback(mine_sweeper_game_screen->view, mine_sweeper_game_screen_view_exit);
 
     // Not being used
     mine_sweeper_game_screen->input_callback = NULL;
+    mine_sweeper_game_screen->wait_callback = NULL;
+    mine_sweeper_game_screen->is_first_move_enabled = first_move_enable;
+    mine_sweeper_game_screen->band_3bv = MineSweeper3bvBandAny;
+    mine_sweeper_game_screen->band_logic = MineSweeperLogicBandAny;
+    mine_sweeper_game_screen->is_refill_pending = false;
+    mine_sweeper_game_screen->is_idle_refill_running = false;
+    mine_sweeper_game_screen->last_input_tick = 0;
+
+    mine_sweeper_game_screen->generator = mine_sweeper_board_generator_alloc();
+
+    // Hardware entropy is only used once here, every board seed after this comes from the software generator
+    mine_sweeper_rng_seed(&mine_sweeper_game_screen->rng, mine_sweeper_rng_entropy_seed());
 
     // Allocate strings in model
     with_view_model(
@@ -1569,7 +1356,13 @@ MineSweeperGameScreen* mine_sweeper_game_screen_alloc(uint8_t width,
         MineSweeperGameScreenModel * model,
         {
             model->info_str = furi_string_alloc();
+            model->board = NULL;
+            model->board_size = 0;
+            model->visited = (MineSweeperVisitedSet){0};
+            model->queue = (MineSweeperTileQueue){0};
+            model->uncleared = (MineSweeperUnclearedIndex){0};
             model->is_holding_down_button = false;
+            model->is_board_pending = false;
             model->wrap_enable = wrap_enable;
         },
         true
@@ -1590,10 +1383,18 @@ void mine_sweeper_game_screen_free(MineSweeperGameScreen* instance) {
         MineSweeperGameScreenModel * model,
         {
             furi_string_free(model->info_str);
+            free_board(&model->board, &model->board_size);
+            free_visited_set(&model->visited);
+            free_tile_queue(&model->queue);
+            free_uncleared_index(&model->uncleared);
         },
         false
     );
 
+    // Stops the worker if it is still building a board
+    mine_sweeper_board_generator_free(instance->generator);
+    free_board_scratch();
+
     // Free view and any dynamically allocated members in main struct
     view_free(instance->view);
     free(instance);
@@ -1603,45 +1404,181 @@ void mine_sweeper_game_screen_free(MineSweeperGameScreen* instance) {
 // This should NOT be called in the on_exit in the game scene
 void mine_sweeper_game_screen_reset(MineSweeperGameScreen* instance, uint8_t width, uint8_t height, uint8_t difficulty, bool ensure_solvable) {
     furi_assert(instance);
-    
-    // We need to initize board width and height before setup
-    mine_sweeper_game_screen_set_board_information(instance, width, height, difficulty, ensure_solvable);
-
-    // Here we are going to generate a valid map for the player 
-    bool is_valid_board = false;
-    size_t memsz = sizeof(MineSweeperTile) * MINESWEEPER_BOARD_MAX_TILES;
-
-    do {
-        setup_board(instance);
-
-        uint16_t num_mines = 1;
-
-        uint16_t board_width = 16; //default values
-        uint16_t board_height = 7; //default values
-
-        with_view_model(
-            instance->view,
-            MineSweeperGameScreenModel * model,
-            {
-                num_mines = model->mines_left;
-                board_width = model->board_width;
-                board_height = model->board_height;
-
-                memset(board_t, 0, memsz);
-                memcpy(board_t, model->board, sizeof(MineSweeperTile) * (board_width * board_height));
-            },
-            true
-        );
-    
-        if (ensure_solvable) is_valid_board = check_board_with_verifier(board_t, board_width, board_height, num_mines);
 
-    } while (ensure_solvable && !is_valid_board);
+    MineSweeperBoardConfig config = mine_sweeper_game_screen_make_board_config(instance, width, height, difficulty, ensure_solvable);
 
-    view_set_draw_callback(instance->view, mine_sweeper_game_screen_view_play_draw_callback);
-    view_set_input_callback(instance->view, mine_sweeper_game_screen_view_play_input_callback);
+    if (instance->is_first_move_enabled) {
+        mine_sweeper_game_screen_reset_pending(instance, &config);
+        return;
+    }
 
-    mine_sweeper_game_screen_reset_clock(instance);
+    // If a board was already pre-generated for these settings we reuse its seed so it can be swapped in
+    MineSweeperBoardConfig job_config;
+    uint64_t seed = 0;
+    if (!mine_sweeper_board_generator_get_job(instance->generator, &job_config, &seed) ||
+        !mine_sweeper_board_config_equal(&job_config, &config)) {
+
+        // Otherwise a verified board from the pool is ready right away
+        if (mine_sweeper_board_generator_take_pooled(instance->generator, &config)) {
+            furi_check(mine_sweeper_game_screen_install_board(instance));
+            return;
+        }
+
+        seed = mine_sweeper_rng_next64(&instance->rng);
+    }
+
+    mine_sweeper_game_screen_generate_board(instance, &config, seed);
+}
+
+void mine_sweeper_game_screen_reset_with_seed(
+        MineSweeperGameScreen* instance,
+        uint8_t width,
+        uint8_t height,
+        uint8_t difficulty,
+        bool ensure_solvable,
+        uint64_t seed) {
+
+    furi_assert(instance);
+
+    MineSweeperBoardConfig config = mine_sweeper_game_screen_make_board_config(instance, width, height, difficulty, ensure_solvable);
+
+    mine_sweeper_game_screen_generate_board(instance, &config, seed);
+}
+
+void mine_sweeper_game_screen_prepare(
+        MineSweeperGameScreen* instance,
+        uint8_t width,
+        uint8_t height,
+        uint8_t difficulty,
+        bool ensure_solvable) {
+
+    furi_assert(instance);
+
+    MineSweeperBoardConfig config = mine_sweeper_game_screen_make_board_config(instance, width, height, difficulty, ensure_solvable);
+
+    // Keep a running or finished job for these settings, it may have been started in the background already
+    MineSweeperBoardConfig job_config;
+    if (mine_sweeper_board_generator_get_job(instance->generator, &job_config, NULL) &&
+        mine_sweeper_board_config_equal(&job_config, &config)) {
+        return;
+    }
+
+    if (mine_sweeper_board_generator_take_pooled(instance->generator, &config)) {
+        return;
+    }
+
+    mine_sweeper_game_screen_start_budgeted_job(instance, &config);
+}
+
+bool mine_sweeper_game_screen_apply_prepared_board(MineSweeperGameScreen* instance) {
+    furi_assert(instance);
 
+    return mine_sweeper_game_screen_install_board(instance);
+}
+
+void mine_sweeper_game_screen_cancel_generation(MineSweeperGameScreen* instance) {
+    furi_assert(instance);
+
+    mine_sweeper_board_generator_cancel(instance->generator);
+}
+
+MineSweeperBoardGeneratorProgress mine_sweeper_game_screen_get_generation_progress(MineSweeperGameScreen* instance) {
+    furi_assert(instance);
+
+    return mine_sweeper_board_generator_get_progress(instance->generator);
+}
+
+void mine_sweeper_game_screen_set_generation_callback(
+        MineSweeperGameScreen* instance,
+        MineSweeperBoardGeneratorCallback callback,
+        void* context) {
+
+    furi_assert(instance);
+
+    mine_sweeper_board_generator_set_callback(instance->generator, callback, context);
+}
+
+void mine_sweeper_game_screen_set_wait_callback(MineSweeperGameScreen* instance, GameScreenWaitCallback callback) {
+    furi_assert(instance);
+
+    instance->wait_callback = callback;
+}
+
+uint64_t mine_sweeper_game_screen_get_seed(MineSweeperGameScreen* instance) {
+    furi_assert(instance);
+
+    uint64_t seed = 0;
+
+    with_view_model(
+        instance->view,
+        MineSweeperGameScreenModel * model,
+        {
+            seed = model->board_seed;
+        },
+        false
+    );
+
+    return seed;
+}
+
+uint16_t mine_sweeper_game_screen_get_3bv(MineSweeperGameScreen* instance) {
+    furi_assert(instance);
+
+    uint16_t board_3bv = 0;
+
+    with_view_model(
+        instance->view,
+        MineSweeperGameScreenModel * model,
+        {
+            board_3bv = model->board_3bv;
+        },
+        false
+    );
+
+    return board_3bv;
+}
+
+// The next board may already be generated for the old band, a pool refill is left running
+static void mine_sweeper_game_screen_drop_next_board(MineSweeperGameScreen* instance) {
+    if (mine_sweeper_board_generator_get_job(instance->generator, NULL, NULL)) {
+        mine_sweeper_board_generator_cancel(instance->generator);
+    }
+}
+
+void mine_sweeper_game_screen_set_3bv_band(MineSweeperGameScreen* instance, MineSweeper3bvBand band) {
+    furi_assert(instance);
+    furi_assert(band < MineSweeper3bvBandCount);
+
+    if (instance->band_3bv == band) {
+        return;
+    }
+
+    instance->band_3bv = band;
+    mine_sweeper_game_screen_drop_next_board(instance);
+}
+
+void mine_sweeper_game_screen_set_logic_band(MineSweeperGameScreen* instance, MineSweeperLogicBand band) {
+    furi_assert(instance);
+    furi_assert(band < MineSweeperLogicBandCount);
+
+    if (instance->band_logic == band) {
+        return;
+    }
+
+    instance->band_logic = band;
+    mine_sweeper_game_screen_drop_next_board(instance);
+}
+
+void mine_sweeper_game_screen_refill_when_idle(MineSweeperGameScreen* instance) {
+    furi_assert(instance);
+
+    if (!instance->is_refill_pending ||
+        furi_get_tick() - instance->last_input_tick < furi_ms_to_ticks(MINESWEEPER_REFILL_IDLE_MS)) {
+        return;
+    }
+
+    mine_sweeper_game_screen_start_pending_refill(instance);
+    instance->is_idle_refill_running = true;
 }
 
 // This function should be called when you want to reset the game clock
@@ -1682,3 +1619,9 @@ void mine_sweeper_game_screen_set_wrap_enable(MineSweeperGameScreen* instance, u
         true
     );
 }
+
+void mine_sweeper_game_screen_set_first_move_enable(MineSweeperGameScreen* instance, uint8_t first_move_enable) {
+    furi_assert(instance);
+
+    instance->is_first_move_enabled = first_move_enable;
+}
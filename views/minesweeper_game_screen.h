@@ -20,12 +20,13 @@
 
 #include "minesweeper_redux_icons.h"
 #include "minesweeper_game_screen_i.h"
+#include "minesweeper_engine.h"
+#include "minesweeper_bitboard.h"
+#include "minesweeper_board_generator.h"
 #include "../helpers/mine_sweeper_haptic.h"
 #include "../helpers/mine_sweeper_led.h"
 #include "../helpers/mine_sweeper_speaker.h"
-
-// MAX TILES ALLOWED
-#define MINESWEEPER_BOARD_MAX_TILES  (1<<10)
+#include "../helpers/mine_sweeper_rng.h"
 
 // These defines represent how many tiles
 // can be visually representen on the screen 
@@ -35,10 +36,36 @@
 
 #define MS_DEBUG_TAG  "Mine Sweeper Module/View"
 
+// Limits for a board that is generated while the player waits on the progress screen
+#define MINESWEEPER_GENERATION_MAX_ATTEMPTS 20000
+#define MINESWEEPER_GENERATION_MAX_MS (60 * 1000)
+
+// Limit for a banded board the GUI thread waits on without the progress screen, the band is dropped after half of it
+#define MINESWEEPER_GENERATION_BLOCKING_MS 1000
+
+// Time without input after which the SD card pool is refilled during a game
+#define MINESWEEPER_REFILL_IDLE_MS (10 * 1000)
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+// Boards to accept by how many clicks they take to clear, see mine_sweeper_game_screen_set_3bv_band
+typedef enum {
+    MineSweeper3bvBandAny,
+    MineSweeper3bvBandLow,      // At most the median 3BV
+    MineSweeper3bvBandHigh,     // At least the median 3BV
+    MineSweeper3bvBandCount,
+} MineSweeper3bvBand;
+
+// Boards to accept by the deepest rule the verifier needs, see mine_sweeper_game_screen_set_logic_band
+typedef enum {
+    MineSweeperLogicBandAny,
+    MineSweeperLogicBandSimple,     // Every tile can be decided from its own number
+    MineSweeperLogicBandSubsets,    // At least one step needs two overlapping numbers
+    MineSweeperLogicBandCount,
+} MineSweeperLogicBand;
+
 /** MineSweeperGameScreen anonymous structure */
 typedef struct MineSweeperGameScreen MineSweeperGameScreen;
 
@@ -47,6 +74,12 @@ typedef struct MineSweeperGameScreen MineSweeperGameScreen;
  */
 typedef bool (*GameScreenInputCallback)(InputEvent* event, void* context);
 
+/** Called when the game has to wait on board generation, either on a restart
+ * before the next board is ready or on the first move of a board that is generated then
+ * @warning     comes from GUI thread
+ */
+typedef void (*GameScreenWaitCallback)(void* context);
+
 /** Allocate and initalize
  *
  * This view is used as the game screen of an application.
@@ -62,7 +95,8 @@ MineSweeperGameScreen* mine_sweeper_game_screen_alloc(
         uint8_t height,
         uint8_t difficulty,
         bool ensure_solvable,
-        uint8_t wrap_enable);
+        uint8_t wrap_enable,
+        uint8_t first_move_enable);
 
 /** Deinitialize and free Start Screen view
  *
@@ -71,6 +105,9 @@ MineSweeperGameScreen* mine_sweeper_game_screen_alloc(
 void mine_sweeper_game_screen_free(MineSweeperGameScreen* instance);
 
 /** Reset MineSweeperGameScreen
+ *
+ * Blocks until the board is generated. With first move generation enabled the new game
+ * starts right away and the board is only generated on the first OK press.
  *
  * @param       instance    MineSweeperGameScreen* instance
  * @param       width       uint8_t width for board
@@ -84,6 +121,134 @@ void mine_sweeper_game_screen_reset(
         uint8_t difficulty,
         bool ensure_solvable);
 
+/** Reset MineSweeperGameScreen with an explicit generator seed
+ *
+ * The same seed with the same width, height, difficulty and
+ * ensure_solvable always produces the same board. This always
+ * generates a board with safe corners, even with first move generation enabled.
+ *
+ * @param       instance    MineSweeperGameScreen* instance
+ * @param       width       uint8_t width for board
+ * @param       height      uint8_t height for board
+ * @param       difficulty  uint8_t difficulty for board
+ * @param       seed        uint64_t seed for the board generator
+ */
+void mine_sweeper_game_screen_reset_with_seed(
+        MineSweeperGameScreen* instance,
+        uint8_t width,
+        uint8_t height,
+        uint8_t difficulty,
+        bool ensure_solvable,
+        uint64_t seed);
+
+/** Start generating a board for these settings without touching the current game
+ *
+ * A job that is already running or finished for the same settings is kept,
+ * otherwise a verified board is taken from the SD card pool when there is one.
+ * New jobs are limited by MINESWEEPER_GENERATION_MAX_ATTEMPTS and MINESWEEPER_GENERATION_MAX_MS.
+ *
+ * @param       instance    MineSweeperGameScreen* instance
+ * @param       width       uint8_t width for board
+ * @param       height      uint8_t height for board
+ * @param       difficulty  uint8_t difficulty for board
+ */
+void mine_sweeper_game_screen_prepare(
+        MineSweeperGameScreen* instance,
+        uint8_t width,
+        uint8_t height,
+        uint8_t difficulty,
+        bool ensure_solvable);
+
+/** Start a new game on the generated board if it is finished
+ *
+ * @param       instance    MineSweeperGameScreen* instance
+ *
+ * @return      true if the board was ready and the game was reset
+ */
+bool mine_sweeper_game_screen_apply_prepared_board(MineSweeperGameScreen* instance);
+
+/** Cancel the board generation in progress
+ *
+ * @param       instance    MineSweeperGameScreen* instance
+ */
+void mine_sweeper_game_screen_cancel_generation(MineSweeperGameScreen* instance);
+
+/** Get the progress of the board generation
+ *
+ * @param       instance    MineSweeperGameScreen* instance
+ *
+ * @return      MineSweeperBoardGeneratorProgress snapshot
+ */
+MineSweeperBoardGeneratorProgress mine_sweeper_game_screen_get_generation_progress(MineSweeperGameScreen* instance);
+
+/** Set the board generation progress callback
+ *
+ * @param       instance    MineSweeperGameScreen* instance
+ * @param       callback    MineSweeperBoardGeneratorCallback callback, comes from the worker thread
+ * @param       context     void* context for callback
+ */
+void mine_sweeper_game_screen_set_generation_callback(
+        MineSweeperGameScreen* instance,
+        MineSweeperBoardGeneratorCallback callback,
+        void* context);
+
+/** Set the callback for when the game has to wait on board generation
+ *
+ * @param       instance    MineSweeperGameScreen* instance
+ * @param       callback    GameScreenWaitCallback callback, called with the game screen context
+ */
+void mine_sweeper_game_screen_set_wait_callback(MineSweeperGameScreen* instance, GameScreenWaitCallback callback);
+
+/** Get the seed the current board was generated from
+ *
+ * @param       instance    MineSweeperGameScreen* instance
+ *
+ * @return      uint64_t seed that can be passed to mine_sweeper_game_screen_reset_with_seed
+ */
+uint64_t mine_sweeper_game_screen_get_seed(MineSweeperGameScreen* instance);
+
+/** Get the 3BV of the current board
+ *
+ * @param       instance    MineSweeperGameScreen* instance
+ *
+ * @return      uint16_t 3BV of the board, 0 while the board waits on the first move
+ */
+uint16_t mine_sweeper_game_screen_get_3bv(MineSweeperGameScreen* instance);
+
+/** Only accept boards with a 3BV in this band
+ *
+ * The band is worked out for the size and difficulty of each board from the median 3BV of random boards,
+ * so about half of the boards fall in either band. It takes effect from the next reset, the current game
+ * is kept but a board already generated for the next game is dropped. Banded boards are never taken from
+ * the SD card pool. The generator searches the band for the first half of the budget of a job and then
+ * takes a board without it, so a band no board falls in still gives a game.
+ *
+ * @param       instance    MineSweeperGameScreen* instance
+ * @param       band        MineSweeper3bvBand boards to accept
+ */
+void mine_sweeper_game_screen_set_3bv_band(MineSweeperGameScreen* instance, MineSweeper3bvBand band);
+
+/** Only accept boards the verifier grades within this band
+ *
+ * The band is on the deepest rule the verifier needs, the passes and the largest frontier grow with
+ * the board size and are left open. Boards are verified whenever a band is set, even without
+ * ensure_solvable. Simple boards are rare on large or hard settings, the band is then dropped
+ * like the 3BV band once half of the budget is gone.
+ *
+ * @param       instance    MineSweeperGameScreen* instance
+ * @param       band        MineSweeperLogicBand boards to accept
+ */
+void mine_sweeper_game_screen_set_logic_band(MineSweeperGameScreen* instance, MineSweeperLogicBand band);
+
+/** Refill the SD card pool if the player has not pressed anything for a while
+ *
+ * Called on every tick of the game screen scene. The next key press stops the refill and waits for a board
+ * or a write to the SD card that is already under way, so the card is only written during a game while nobody is playing.
+ *
+ * @param       instance    MineSweeperGameScreen* instance
+ */
+void mine_sweeper_game_screen_refill_when_idle(MineSweeperGameScreen* instance);
+
 /** Reset MineSweeperGameScreen clock 
  *
  * @param       instance    MineSweeperGameScreen* instance
@@ -106,6 +271,15 @@ View* mine_sweeper_game_screen_get_view(MineSweeperGameScreen* instance);
 void mine_sweeper_game_screen_set_context(MineSweeperGameScreen* instance, void* context);
 
 void mine_sweeper_game_screen_set_wrap_enable(MineSweeperGameScreen* instance, uint8_t wrap_enabled);
+
+/** Set whether new boards are generated around the first OK press
+ *
+ * Takes effect from the next reset, the current game is kept.
+ *
+ * @param       instance            MineSweeperGameScreen* instance
+ * @param       first_move_enable   uint8_t 1 to generate on the first move, 0 to generate up front
+ */
+void mine_sweeper_game_screen_set_first_move_enable(MineSweeperGameScreen* instance, uint8_t first_move_enable);
 #define inverted_canvas_white_to_black(canvas, code)      \
     {                                           \
         canvas_set_color(canvas, ColorWhite);   \
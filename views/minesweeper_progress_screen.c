@@ -0,0 +1,155 @@
+#include "minesweeper_progress_screen.h"
+#include <gui/elements.h>
+#include <input/input.h>
+
+#include <furi.h>
+
+struct MineSweeperProgressScreen {
+    View* view;
+};
+
+typedef struct {
+    MineSweeperBoardGeneratorProgress progress;
+    FuriString* info_str;
+} MineSweeperProgressScreenModel;
+
+static void mine_sweeper_progress_screen_view_draw_callback(Canvas* canvas, void* _model) {
+    furi_assert(canvas);
+    furi_assert(_model);
+    MineSweeperProgressScreenModel* model = _model;
+
+    canvas_clear(canvas);
+    canvas_set_color(canvas, ColorBlack);
+
+    const MineSweeperBoardGeneratorProgress* progress = &model->progress;
+    bool has_failed = progress->state == MineSweeperBoardGeneratorStateFailed;
+
+    canvas_set_font(canvas, FontPrimary);
+    canvas_draw_str_aligned(
+        canvas,
+        64,
+        2,
+        AlignCenter,
+        AlignTop,
+        has_failed ? "No Board Found" : "Generating Board");
+
+    uint32_t elapsed_s = progress->elapsed_ticks / furi_kernel_get_tick_frequency();
+
+    furi_string_printf(
+        model->info_str,
+        "Attempts: %lu  Time: %lu:%02lu",
+        (unsigned long)progress->attempts,
+        (unsigned long)(elapsed_s / 60),
+        (unsigned long)(elapsed_s % 60));
+
+    canvas_set_font(canvas, FontSecondary);
+    canvas_draw_str_aligned(canvas, 64, 18, AlignCenter, AlignTop, furi_string_get_cstr(model->info_str));
+
+    if (has_failed) {
+        canvas_draw_str_aligned(canvas, 64, 32, AlignCenter, AlignTop, "Try smaller or easier");
+        canvas_draw_str_aligned(canvas, 64, 42, AlignCenter, AlignTop, "settings");
+    } else {
+        // Fill against whichever budget is closer to running out
+        float fill = 0.0f;
+        uint32_t max_ticks = furi_ms_to_ticks(progress->budget.max_ms);
+
+        if (max_ticks != 0) {
+            fill = (float)progress->elapsed_ticks / (float)max_ticks;
+        }
+
+        if (progress->budget.max_attempts != 0) {
+            float attempts_fill = (float)progress->attempts / (float)progress->budget.max_attempts;
+            if (attempts_fill > fill) fill = attempts_fill;
+        }
+
+        if (fill > 1.0f) fill = 1.0f;
+
+        elements_progress_bar(canvas, 4, 32, 120, fill);
+    }
+
+    canvas_draw_str_aligned(canvas, 64, 62, AlignCenter, AlignBottom, "Back to cancel");
+}
+
+static bool mine_sweeper_progress_screen_view_input_callback(InputEvent* event, void* context) {
+    UNUSED(context);
+    furi_assert(event);
+
+    // Let the scene handle back so it can cancel the job, everything else is swallowed
+    return event->key != InputKeyBack;
+}
+
+MineSweeperProgressScreen* mine_sweeper_progress_screen_alloc() {
+    MineSweeperProgressScreen* progress_screen = malloc(sizeof(MineSweeperProgressScreen));
+
+    progress_screen->view = view_alloc();
+
+    view_allocate_model(progress_screen->view, ViewModelTypeLocking, sizeof(MineSweeperProgressScreenModel));
+
+    with_view_model(
+        progress_screen->view,
+        MineSweeperProgressScreenModel * model,
+        {
+            memset(&model->progress, 0, sizeof(model->progress));
+            model->info_str = furi_string_alloc();
+        },
+        false
+    );
+
+    view_set_context(progress_screen->view, progress_screen);
+    view_set_draw_callback(progress_screen->view, mine_sweeper_progress_screen_view_draw_callback);
+    view_set_input_callback(progress_screen->view, mine_sweeper_progress_screen_view_input_callback);
+
+    return progress_screen;
+}
+
+void mine_sweeper_progress_screen_free(MineSweeperProgressScreen* instance) {
+    furi_assert(instance);
+
+    with_view_model(
+        instance->view,
+        MineSweeperProgressScreenModel * model,
+        {
+            furi_string_free(model->info_str);
+        },
+        false
+    );
+
+    view_free(instance->view);
+    free(instance);
+}
+
+View* mine_sweeper_progress_screen_get_view(MineSweeperProgressScreen* instance) {
+    furi_assert(instance);
+    return instance->view;
+}
+
+void mine_sweeper_progress_screen_reset(MineSweeperProgressScreen* instance) {
+    furi_assert(instance);
+
+    with_view_model(
+        instance->view,
+        MineSweeperProgressScreenModel * model,
+        {
+            memset(&model->progress, 0, sizeof(model->progress));
+            model->progress.state = MineSweeperBoardGeneratorStateRunning;
+        },
+        true
+    );
+}
+
+void mine_sweeper_progress_screen_set_progress(
+        MineSweeperProgressScreen* instance,
+        const MineSweeperBoardGeneratorProgress* progress) {
+
+    furi_assert(instance);
+    furi_assert(progress);
+
+    with_view_model(
+        instance->view,
+        MineSweeperProgressScreenModel * model,
+        {
+            model->progress = *progress;
+        },
+        true
+    );
+}
@@ -0,0 +1,63 @@
+/**
+ * @file minesweeper_progress_screen.h
+ * GUI: Board generation progress view module API
+ */
+
+#ifndef MINESWEEPER_PROGRESS_SCREEN_H
+#define MINESWEEPER_PROGRESS_SCREEN_H
+
+#include <gui/view.h>
+#include "minesweeper_board_generator.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** MineSweeperProgressScreen anonymous structure */
+typedef struct MineSweeperProgressScreen MineSweeperProgressScreen;
+
+/** Allocate and initalize
+ *
+ * This view shows the progress of a board generation job.
+ * Back input is not consumed so the scene can cancel the job.
+ *
+ * @return      MineSweeperProgressScreen view instance
+ */
+MineSweeperProgressScreen* mine_sweeper_progress_screen_alloc();
+
+/** Deinitialize and free MineSweeperProgressScreen view
+ *
+ * @param       instance MineSweeperProgressScreen instance
+ */
+void mine_sweeper_progress_screen_free(MineSweeperProgressScreen* instance);
+
+/** Get MineSweeperProgressScreen view
+ *
+ * @param       instance MineSweeperProgressScreen instance
+ *
+ * @return      view instance that can be used for embedding
+ */
+View* mine_sweeper_progress_screen_get_view(MineSweeperProgressScreen* instance);
+
+/** Reset MineSweeperProgressScreen for a new job
+ *
+ * @param       instance MineSweeperProgressScreen instance
+ */
+void mine_sweeper_progress_screen_reset(MineSweeperProgressScreen* instance);
+
+/** Update the shown progress
+ *
+ * A failed state switches the view to the failure message.
+ *
+ * @param       instance MineSweeperProgressScreen instance
+ * @param       progress MineSweeperBoardGeneratorProgress snapshot
+ */
+void mine_sweeper_progress_screen_set_progress(
+        MineSweeperProgressScreen* instance,
+        const MineSweeperBoardGeneratorProgress* progress);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif